@@ -0,0 +1,337 @@
+/**
+ * hand ̐M̃}CNx`}[N
+ *
+ * LeapMotion I[fBIfoCXg킸ɁAHandAudioCallback ̊eobt@TCY 16 .. 1024 
+ * Ă{CX̐ςȂvAns/sample  JSON ɏo
+ *
+ *	benchmark --json=result.json --label=$(git rev-parse --short HEAD)
+ *
+ *  WAV t@CJgfBNgɖ΁A WAV t@CoĂg
+ *
+ * Linux ł Gamma  LeapSDK  boost ̃wb_[ƃCupӂĎ̂悤Ƀrh
+ *
+ *	g++ -std=c++17 -O2 -DNDEBUG -I../main -I<Gamma> -I<LeapSDK>/include -I<boost> \
+ *		HandBenchmark.cpp ../main/HandAudioCallback.cpp ../main/Config.cpp \
+ *		../main/locked_buffer.cpp ../main/mapped_file.cpp ../main/realtime_check.cpp \
+ *		-L<Gamma>/build/lib -L<LeapSDK>/lib/x64 -lGamma -lsndfile -lportaudio -lLeap -lpthread -o benchmark
+ */
+
+#include "benchmark.h"
+
+#include "HandAudioCallback.h"
+#include "LeapSoundController.h"
+#include "LoopFinder.h"
+
+#include <Gamma/SoundFile.h>
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+/// x`}[Np HandAudioCallback ̓𑀍삷
+class HandAudioCallbackBenchmark
+{
+public:
+	typedef HandAudioCallback::Page Page;
+
+private:
+	LeapSoundController leap_;
+	HandAudioCallback audio_;
+
+	std::vector< float > in_;
+	std::vector< float > out_l_;
+	std::vector< float > out_r_;
+
+	std::vector< HandAudioCallback::OneShotPlayer* > one_shots_;
+	int voices_ = 0;
+
+public:
+	static const int MAX_VOICES = HandAudioCallback::TAP_VOICES;
+
+	explicit HandAudioCallbackBenchmark( int frames )
+		: audio_( leap_, 44100.0, frames )
+		, in_( frames, 0.f )
+		, out_l_( frames, 0.f )
+		, out_r_( frames, 0.f )
+	{
+		one_shots_ = {
+			& audio_.rock_, & audio_.scissors_, & audio_.paper_, & audio_.thumbs_up_, & audio_.fox_,
+			& audio_.sound_1_, & audio_.sound_2_, & audio_.sound_3_,
+			& audio_.page_down, & audio_.page_up,
+		};
+
+		for ( int n = 0; n < frames; n++ )
+		{
+			in_[ n ] = 0.1f * std::sin( n * 0.05f );
+		}
+
+		// 肪tłʒuɂԂɂĂ
+		LeapSoundController::Snapshot snapshot = LeapSoundController::Snapshot();
+		snapshot.hand_count = 2;
+		snapshot.is_lh_valid = true;
+		snapshot.is_rh_valid = true;
+		snapshot.lh_pos = Leap::Vector( -100.f, 200.f, -50.f );
+		snapshot.rh_pos = Leap::Vector( 100.f, 250.f, -50.f );
+		leap_.publish_snapshot( snapshot );
+
+		audio_.snapshot_ = & leap_.read_snapshot();
+	}
+
+	HandAudioCallback& audio() { return audio_; }
+
+	HandAudioCallback::Block block()
+	{
+		return HandAudioCallback::Block { & in_[ 0 ], { & out_l_[ 0 ], & out_r_[ 0 ] }, static_cast< int >( in_.size() ) };
+	}
+
+	void set_page( Page page )
+	{
+		leap_.set_page( static_cast< int >( page ) );
+		audio_.page = page;
+		audio_.compile_page();
+	}
+
+	/// ^bṽ{CX voices 炵Ả͎~߂Ă
+	void set_active_voices( int voices )
+	{
+		voices_ = voices;
+
+		for ( auto* player : one_shots_ )
+		{
+			player->pos( player->max() - 1.0 );
+		}
+
+		audio_.kick.stop();
+		audio_.snare.stop();
+		audio_.bright.stop();
+		audio_.tap.stop();
+
+		keep_voices_active();
+	}
+
+	/// I{CX̑炵āA{CX̐ۂ
+	void keep_voices_active()
+	{
+		while ( audio_.tap.get_active_count() < voices_ )
+		{
+			audio_.tap.trigger().start();
+		}
+	}
+
+	Limiter& limiter() { return audio_.limiter_; }
+
+	StereoDelay& delay() { return audio_.delay_; }
+};
+
+///  WAV t@C΁ATCg WAV t@Co
+static void write_synthetic_samples()
+{
+	const char* names[] = {
+		"page_down.wav", "page_up.wav", "tap.wav", "kick.wav", "a.wav",
+		"rock.wav", "scissors.wav", "paper.wav", "thumbs_up.wav", "fox.wav", "1.wav", "2.wav", "3.wav",
+	};
+
+	const int frames = 44100;
+	std::vector< float > samples( frames );
+
+	for ( int n = 0; n < frames; n++ )
+	{
+		samples[ n ] = std::sin( 2.f * 3.14159265f * 220.f * n / 44100.f ) * std::exp( -3.f * n / frames );
+	}
+
+	for ( const char* name : names )
+	{
+		if ( std::ifstream( name ) )
+		{
+			continue;
+		}
+
+		gam::SoundFile file( name );
+		file.format( gam::SoundFile::WAV ).encoding( gam::SoundFile::FLOAT ).channels( 1 ).frameRate( 44100 );
+
+		if ( file.openWrite() )
+		{
+			file.write( & samples[ 0 ], frames );
+			file.close();
+		}
+	}
+}
+
+static void register_benchmarks()
+{
+	typedef HandAudioCallbackBenchmark::Page Page;
+
+	const std::vector< int > voices = { 0, 4, HandAudioCallbackBenchmark::MAX_VOICES };
+
+	// QƎ : TvɑSẴvC[炵A~bNXERvbT[EfBC܂ōs
+	bench::add( "mix", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+		b.set_page( Page::CLIMAX );
+		b.set_active_voices( state.voices() );
+
+		const auto block = b.block();
+
+		while ( state.keep_running() )
+		{
+			b.keep_voices_active();
+
+			for ( int n = 0; n < block.frames; n++ )
+			{
+				b.audio().mix( block, n );
+			}
+
+			bench::do_not_optimize( block.out[ 0 ][ 0 ] );
+		}
+	}, bench::buffer_sizes(), voices );
+
+	// ubNPʂ̃_OS ( Xebv̏܂ )
+	bench::add( "render_block", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+		b.set_page( Page::CLIMAX );
+		b.set_active_voices( state.voices() );
+
+		const auto block = b.block();
+
+		while ( state.keep_running() )
+		{
+			b.keep_voices_active();
+			b.audio().render_block( block );
+
+			bench::do_not_optimize( block.out[ 0 ][ 0 ] );
+		}
+	}, bench::buffer_sizes(), voices );
+
+	// قƂǂ̃p[g̉ʂ 0 ̃y[Wł̃ubNPʂ̃_O
+	bench::add( "render_block_rps", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+		b.set_page( Page::RPS );
+		b.set_active_voices( state.voices() );
+
+		const auto block = b.block();
+
+		while ( state.keep_running() )
+		{
+			b.keep_voices_active();
+			b.audio().render_block( block );
+
+			bench::do_not_optimize( block.out[ 0 ][ 0 ] );
+		}
+	}, bench::buffer_sizes(), voices );
+
+	bench::add( "limiter", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+
+		const auto block = b.block();
+
+		while ( state.keep_running() )
+		{
+			for ( int n = 0; n < block.frames; n++ )
+			{
+				block.out[ 0 ][ n ] = block.in[ n ] * 4.f;
+				block.out[ 1 ][ n ] = block.in[ n ] * 4.f;
+			}
+
+			b.limiter().process( block.out[ 0 ], block.out[ 1 ], block.frames );
+
+			bench::do_not_optimize( block.out[ 0 ][ 0 ] );
+		}
+	}, bench::buffer_sizes() );
+
+	bench::add( "delay", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+		b.set_page( Page::CLIMAX );
+
+		const auto block = b.block();
+
+		while ( state.keep_running() )
+		{
+			dsp::copy( block.out[ 0 ], block.in, block.frames );
+			dsp::copy( block.out[ 1 ], block.in, block.frames );
+
+			b.delay().process( block.in, block.out[ 0 ], block.out[ 1 ], block.frames );
+
+			bench::do_not_optimize( block.out[ 0 ][ 0 ] );
+		}
+	}, bench::buffer_sizes() );
+
+	bench::add( "update_lead", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+		b.set_page( Page::CLIMAX );
+
+		while ( state.keep_running() )
+		{
+			for ( int n = 0; n < state.frames(); n++ )
+			{
+				b.audio().update_lead();
+			}
+		}
+	}, bench::buffer_sizes() );
+
+	bench::add( "update_bass", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+		b.set_page( Page::BASS );
+
+		while ( state.keep_running() )
+		{
+			for ( int n = 0; n < state.frames(); n++ )
+			{
+				b.audio().update_bass();
+			}
+		}
+	}, bench::buffer_sizes() );
+
+	// ubNPʂ̃x[Xƃ[h̃p[^̌vZ
+	bench::add( "update_control", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( state.frames() );
+		b.set_page( Page::BASS );
+
+		while ( state.keep_running() )
+		{
+			b.audio().update_control( 0, state.frames() );
+		}
+	}, bench::buffer_sizes() );
+
+	// 1 Xebv̏B1 Xebv 16  1 ̃TvƂĐ
+	bench::add( "on_note", [] ( bench::State& state ) {
+		HandAudioCallbackBenchmark b( 64 );
+		b.set_page( Page::CLIMAX );
+		state.set_samples_per_iteration( b.audio().get_frames_per_step() );
+
+		while ( state.keep_running() )
+		{
+			b.audio().on_timer();
+		}
+	} );
+
+	bench::add( "loop_finder", [] ( bench::State& state ) {
+		std::vector< float > source( state.frames() * 64 );
+		std::vector< float > samples( source.size() );
+		state.set_samples_per_iteration( samples.size() );
+
+		for ( size_t n = 0; n < source.size(); n++ )
+		{
+			source[ n ] = std::sin( n * 0.01f );
+		}
+
+		const LoopFinder finder( AudioCallback::DEFAULT_FRAMES_PER_SECOND );
+
+		while ( state.keep_running() )
+		{
+			// apply() ͏̂ŁA񓯂Mn߂
+			dsp::copy( & samples[ 0 ], & source[ 0 ], static_cast< int >( source.size() ) );
+
+			const LoopFinder::Loop loop = finder.find( & samples[ 0 ], static_cast< int >( samples.size() ) );
+			LoopFinder::apply( & samples[ 0 ], loop );
+
+			bench::do_not_optimize( samples[ 0 ] );
+		}
+	}, bench::buffer_sizes() );
+}
+
+int main( int argc, char** argv )
+{
+	write_synthetic_samples();
+	register_benchmarks();
+
+	return bench::run( argc, argv );
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Google Benchmark ̏ȃx`}[Ñn[lX
+ *
+ * bench::add() œo^֐ ( t[ƃ{CX ) ̑gݍ킹ɎsA
+ * 1 񂠂 1 Tv̎ԂR\[ JSON t@Cɏo
+ *
+ *	bench::add( "limiter", [] ( bench::State& state ) {
+ *		...  ...
+ *		while ( state.keep_running() )
+ *		{
+ *			... v鏈 ...
+ *		}
+ *	}, { 16, 64, 256 } );
+ */
+namespace bench
+{
+
+/// v̏
+class State
+{
+public:
+	typedef std::chrono::steady_clock clock;
+
+private:
+	int frames_;
+	int voices_;
+	double min_time_;
+
+	int64_t iterations_ = 0;
+	int64_t samples_per_iteration_;
+	clock::time_point start_time_;
+	double elapsed_ = 0.0;
+	bool is_running_ = false;
+
+public:
+	State( int frames, int voices, double min_time )
+		: frames_( frames )
+		, voices_( voices )
+		, min_time_( min_time )
+		, samples_per_iteration_( frames )
+	{
+
+	}
+
+	int frames() const { return frames_; }
+	int voices() const { return voices_; }
+
+	/// 1 񂠂ɏTv ( ł̓t[ )
+	void set_samples_per_iteration( int64_t samples ) { samples_per_iteration_ = samples; }
+
+	/// v𑱂邩ǂBŏɌĂ΂ꂽvn߁Amin_time b𒴂 false Ԃ
+	bool keep_running()
+	{
+		if ( ! is_running_ )
+		{
+			is_running_ = true;
+			start_time_ = clock::now();
+			return true;
+		}
+
+		iterations_++;
+
+		// vǂމ񐔂炷߁AoߎԂ 2 ̗ݏ񖈂ɒׂ
+		if ( ( iterations_ & ( iterations_ - 1 ) ) == 0 || ( iterations_ & 1023 ) == 0 )
+		{
+			elapsed_ = std::chrono::duration< double >( clock::now() - start_time_ ).count();
+
+			if ( elapsed_ >= min_time_ )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	int64_t iterations() const { return iterations_; }
+	double elapsed() const { return elapsed_; }
+
+	double ns_per_iteration() const { return iterations_ ? elapsed_ * 1e9 / iterations_ : 0.0; }
+	double ns_per_sample() const { return samples_per_iteration_ ? ns_per_iteration() / samples_per_iteration_ : 0.0; }
+};
+
+/// vZʂgƂɂāAœKŏȂ悤ɂ
+template< typename Type >
+inline void do_not_optimize( const Type& value )
+{
+#if defined( __GNUC__ )
+	asm volatile( "" : : "r,m"( value ) : "memory" );
+#else
+	static volatile char sink;
+	sink = * reinterpret_cast< const volatile char* >( & value );
+#endif
+}
+
+struct Benchmark
+{
+	std::string name;
+	std::function< void( State& ) > function;
+	std::vector< int > frames;
+	std::vector< int > voices;
+};
+
+struct Result
+{
+	std::string name;
+	int frames;
+	int voices;
+	int64_t iterations;
+	double ns_per_iteration;
+	double ns_per_sample;
+};
+
+inline std::vector< Benchmark >& get_benchmarks()
+{
+	static std::vector< Benchmark > benchmarks;
+	return benchmarks;
+}
+
+/// x`}[No^Bframes  voices ̑SĂ̑gݍ킹Ŏs
+inline void add( const std::string& name, std::function< void( State& ) > function, std::vector< int > frames = { 1 }, std::vector< int > voices = { 0 } )
+{
+	get_benchmarks().push_back( Benchmark { name, function, frames, voices } );
+}
+
+/// 16  1024 ܂ł 2 ̗ݏ
+inline std::vector< int > buffer_sizes()
+{
+	return { 16, 32, 64, 128, 256, 512, 1024 };
+}
+
+inline void write_json( std::ostream& out, const std::vector< Result >& results, const std::string& label, double min_time )
+{
+	out << "{\n";
+	out << "  \"context\": { \"label\": \"" << label << "\", \"min_time\": " << min_time << " },\n";
+	out << "  \"benchmarks\": [\n";
+
+	for ( size_t n = 0; n < results.size(); n++ )
+	{
+		const auto& r = results[ n ];
+
+		out << "    { \"name\": \"" << r.name << "\", \"frames\": " << r.frames << ", \"voices\": " << r.voices
+			<< ", \"iterations\": " << r.iterations
+			<< ", \"ns_per_iteration\": " << r.ns_per_iteration
+			<< ", \"ns_per_sample\": " << r.ns_per_sample << " }"
+			<< ( n + 1 < results.size() ? "," : "" ) << "\n";
+	}
+
+	out << "  ]\n";
+	out << "}\n";
+}
+
+/**
+ * o^x`}[Ns
+ *
+ *	--filter=<>	Oɕ܂ނ̂s
+ *	--json=<t@C>	ʂ JSON ŏo
+ *	--min_time=<b>		1 ̌vɂŒ̎ (  0.2 b )
+ *	--label=<>	JSON ɏox ( R~bg̃nbVȂ )
+ */
+inline int run( int argc, char** argv )
+{
+	std::string filter;
+	std::string json_path;
+	std::string label;
+	double min_time = 0.2;
+
+	for ( int n = 1; n < argc; n++ )
+	{
+		const std::string arg = argv[ n ];
+
+		auto value = [ & arg ] ( const char* key ) { return arg.substr( std::strlen( key ) ); };
+
+		if ( arg.compare( 0, 9, "--filter=" ) == 0 ) { filter = value( "--filter=" ); }
+		else if ( arg.compare( 0, 7, "--json=" ) == 0 ) { json_path = value( "--json=" ); }
+		else if ( arg.compare( 0, 11, "--min_time=" ) == 0 ) { min_time = std::atof( value( "--min_time=" ).c_str() ); }
+		else if ( arg.compare( 0, 8, "--label=" ) == 0 ) { label = value( "--label=" ); }
+		else
+		{
+			std::cout << "unknown option : " << arg << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector< Result > results;
+
+	std::cout << std::left << std::setw( 32 ) << "benchmark" << std::right << std::setw( 14 ) << "ns/iter" << std::setw( 12 ) << "ns/sample" << std::setw( 14 ) << "iterations" << std::endl;
+
+	for ( const auto& benchmark : get_benchmarks() )
+	{
+		if ( ! filter.empty() && benchmark.name.find( filter ) == std::string::npos )
+		{
+			continue;
+		}
+
+		for ( int voices : benchmark.voices )
+		{
+			for ( int frames : benchmark.frames )
+			{
+				State state( frames, voices, min_time );
+				benchmark.function( state );
+
+				const std::string name = benchmark.name + "/" + std::to_string( frames ) + "/" + std::to_string( voices );
+
+				results.push_back( Result { name, frames, voices, state.iterations(), state.ns_per_iteration(), state.ns_per_sample() } );
+
+				std::cout << std::left << std::setw( 32 ) << name << std::right << std::fixed << std::setprecision( 1 )
+					<< std::setw( 14 ) << state.ns_per_iteration()
+					<< std::setw( 12 ) << std::setprecision( 3 ) << state.ns_per_sample()
+					<< std::setw( 14 ) << state.iterations() << std::endl;
+			}
+		}
+	}
+
+	if ( ! json_path.empty() )
+	{
+		std::ofstream out( json_path );
+
+		if ( ! out )
+		{
+			std::cout << "could not open : " << json_path << std::endl;
+			return 1;
+		}
+
+		write_json( out, results, label, min_time );
+	}
+
+	return 0;
+}
+
+} // namespace bench
@@ -10,8 +10,16 @@ class AudioCallback : public gam::AudioCallback
 private:
 	gam::AudioIO mAudioIO;
 
+	double frames_per_second_ = DEFAULT_FRAMES_PER_SECOND;
+	unsigned frames_per_buffer_ = DEFAULT_FRAMES_PER_BUFFER;
+
 public:
-	AudioCallback( int in_device_no, int out_device_no )
+	static constexpr double DEFAULT_FRAMES_PER_SECOND = 44100;
+	static const unsigned DEFAULT_FRAMES_PER_BUFFER = 64;
+
+	static const unsigned DEFAULT_CHANNELS_OUT = 2;
+
+	AudioCallback( int in_device_no, int out_device_no, double framesPerSec = DEFAULT_FRAMES_PER_SECOND, unsigned framesPerBuffer = DEFAULT_FRAMES_PER_BUFFER, unsigned outChans = DEFAULT_CHANNELS_OUT )
 	{
 		mAudioIO.append( *this );
 		
@@ -24,7 +32,20 @@ public:
 		mAudioIO.deviceIn( device_in );
 		mAudioIO.deviceOut( device_out );
 
-		initAudio( 44100, 64, 2, 1 );
+		initAudio( framesPerSec, framesPerBuffer, outChans, 1 );
+
+		std::cout << "audio : " << frames_per_second_ << " Hz, " << frames_per_buffer_ << " frames, " << mAudioIO.channelsOut() << " channels" << std::endl;
+	}
+
+	/// ItCŃ_Oꍇ̃RXgN^IԂ߂̃^O
+	struct Offline { };
+
+	/// I[fBIfoCXg킸ɃItCŃ_Oꍇ̃RXgN^
+	AudioCallback( Offline, double framesPerSec, unsigned framesPerBuffer )
+		: frames_per_second_( framesPerSec )
+		, frames_per_buffer_( framesPerBuffer )
+	{
+		gam::sampleRate( framesPerSec );
 	}
 
 	~AudioCallback()
@@ -40,8 +61,14 @@ public:
 		mAudioIO.channelsOut(outChans);
 		mAudioIO.channelsIn(inChans);
 		gam::sampleRate(framesPerSec);
+
+		frames_per_second_ = mAudioIO.framesPerSecond();
+		frames_per_buffer_ = mAudioIO.framesPerBuffer();
 	}
 
+	double get_frames_per_second() const { return frames_per_second_; }
+	unsigned get_frames_per_buffer() const { return frames_per_buffer_; }
+
 	gam::AudioIO& audioIO() { return mAudioIO; }
 	const gam::AudioIO& audioIO() const { return mAudioIO; }
 
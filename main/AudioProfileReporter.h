@@ -0,0 +1,178 @@
+#pragma once
+
+#include "AudioProfiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/**
+ * AudioProfiler ̌vʂIɃR\[ƃt@Cɏo
+ *
+ * I[fBIXbhƂ͕ʂ̃XbhœAAudioProfiler ǂނ
+ * t@C͖ JSON ŏ㏑
+ */
+class AudioProfileReporter
+{
+private:
+	const AudioProfiler& profiler_;
+
+	double interval_;			/// oԊu ( b )
+	std::string file_path_;		/// ot@C ( Ȃ珑oȂ )
+	bool is_console_;			/// R\[ɂ\邩
+
+	std::thread thread_;
+	std::atomic< bool > is_running_;
+
+	static double to_us( double ns ) { return ns / 1000.0; }
+
+public:
+	AudioProfileReporter( const AudioProfiler& profiler, double interval, const std::string& file_path, bool is_console = true )
+		: profiler_( profiler )
+		, interval_( interval )
+		, file_path_( file_path )
+		, is_console_( is_console )
+		, is_running_( false )
+	{
+
+	}
+
+	~AudioProfileReporter()
+	{
+		stop();
+	}
+
+	void start()
+	{
+		if ( is_running_ || interval_ <= 0.0 )
+		{
+			return;
+		}
+
+		is_running_ = true;
+
+		thread_ = std::thread( [this] () {
+			auto next_time = std::chrono::steady_clock::now();
+
+			while ( is_running_ )
+			{
+				next_time += std::chrono::microseconds( static_cast< int64_t >( interval_ * 1000000.0 ) );
+
+				while ( is_running_ && std::chrono::steady_clock::now() < next_time )
+				{
+					std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+				}
+
+				report();
+			}
+		} );
+	}
+
+	void stop()
+	{
+		is_running_ = false;
+
+		if ( thread_.joinable() )
+		{
+			thread_.join();
+		}
+	}
+
+	void report() const
+	{
+		if ( is_console_ )
+		{
+			print( std::cout );
+		}
+
+		if ( ! file_path_.empty() )
+		{
+			std::ofstream out( file_path_ );
+
+			if ( out )
+			{
+				write_json( out );
+			}
+		}
+	}
+
+	/// Ԗ̕ρElE99 p[Z^CEő}CNbŕ\
+	void print( std::ostream& out ) const
+	{
+		out << "---- audio profile : " << profiler_.get_blocks() << " blocks, "
+			<< profiler_.get_overruns() << " overruns, "
+			<< profiler_.get_late_callbacks() << " late callbacks, deadline "
+			<< to_us( static_cast< double >( profiler_.get_deadline() ) ) << " us" << std::endl;
+
+		out << std::fixed << std::setprecision( 1 );
+
+		for ( int n = 0; n < static_cast< int >( AudioProfiler::Section::MAX ); n++ )
+		{
+			const auto section = static_cast< AudioProfiler::Section >( n );
+			const auto& h = profiler_.get_histogram( section );
+
+			out << std::setw( 10 ) << AudioProfiler::get_section_name( section )
+				<< " : mean " << std::setw( 8 ) << to_us( h.get_mean() )
+				<< "  p50 " << std::setw( 8 ) << to_us( static_cast< double >( h.get_percentile( 0.50 ) ) )
+				<< "  p99 " << std::setw( 8 ) << to_us( static_cast< double >( h.get_percentile( 0.99 ) ) )
+				<< "  max " << std::setw( 8 ) << to_us( static_cast< double >( h.get_max() ) ) << std::endl;
+		}
+
+		out << std::setw( 10 ) << "limiter"
+			<< " : gr " << std::setw( 5 ) << profiler_.get_gain_reduction_db() << " dB"
+			<< "  max " << std::setw( 5 ) << profiler_.get_max_gain_reduction_db() << " dB"
+			<< "  " << profiler_.get_limited_blocks() << " blocks" << std::endl;
+
+		out.unsetf( std::ios::floatfield );
+	}
+
+	void write_json( std::ostream& out ) const
+	{
+		out << "{\n";
+		out << "  \"blocks\": " << profiler_.get_blocks() << ",\n";
+		out << "  \"overruns\": " << profiler_.get_overruns() << ",\n";
+		out << "  \"late_callbacks\": " << profiler_.get_late_callbacks() << ",\n";
+		out << "  \"deadline_ns\": " << profiler_.get_deadline() << ",\n";
+		out << "  \"limiter\": { \"gain_reduction_db\": " << profiler_.get_gain_reduction_db()
+			<< ", \"max_gain_reduction_db\": " << profiler_.get_max_gain_reduction_db()
+			<< ", \"limited_blocks\": " << profiler_.get_limited_blocks() << " },\n";
+		out << "  \"sections\": {\n";
+
+		for ( int n = 0; n < static_cast< int >( AudioProfiler::Section::MAX ); n++ )
+		{
+			const auto section = static_cast< AudioProfiler::Section >( n );
+			const auto& h = profiler_.get_histogram( section );
+
+			out << "    \"" << AudioProfiler::get_section_name( section ) << "\": { "
+				<< "\"count\": " << h.get_count() << ", "
+				<< "\"mean_ns\": " << static_cast< uint64_t >( h.get_mean() ) << ", "
+				<< "\"p50_ns\": " << h.get_percentile( 0.50 ) << ", "
+				<< "\"p99_ns\": " << h.get_percentile( 0.99 ) << ", "
+				<< "\"p999_ns\": " << h.get_percentile( 0.999 ) << ", "
+				<< "\"max_ns\": " << h.get_max() << ", "
+				<< "\"buckets\": [";
+
+			// 0 łȂoPbg [ ,  ] ŏo
+			bool is_first = true;
+
+			for ( int b = 0; b < AudioProfiler::Histogram::BUCKETS; b++ )
+			{
+				if ( const uint32_t count = h.get_bucket_count( b ) )
+				{
+					out << ( is_first ? "" : ", " ) << "[" << AudioProfiler::Histogram::get_bucket_upper_bound( b ) << ", " << count << "]";
+					is_first = false;
+				}
+			}
+
+			out << "] }" << ( n + 1 < static_cast< int >( AudioProfiler::Section::MAX ) ? "," : "" ) << "\n";
+		}
+
+		out << "  }\n";
+		out << "}\n";
+	}
+
+}; // class AudioProfileReporter
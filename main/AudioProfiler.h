@@ -0,0 +1,290 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * I[fBIR[obN̏Ԃv
+ *
+ * I[fBIXbh begin_block()  lap()  end_block() ĂԂŁAbN̊mۂȂ
+ * Ԗ 1 ubN̏Ԃ͌Œ蒷̃qXgO atomic ɉZA
+ * ̃Xbh read() łłǂ߂
+ */
+class AudioProfiler
+{
+public:
+	/// v
+	enum class Section
+	{
+		INPUT = 0,		///< ͂̏
+		RECORDING,		///< ^
+		STEP,			///< Xebv̏ƃRg[[g̃p[^̌vZ
+		VOICE,			///< ep[g̃_O
+		MIX,			///< oXւ̍vEfBCE~b^[
+		OUTPUT,			///< }CÑ~bNXƏo̓obt@ւ̏
+		BLOCK,			///< 1 ubNS
+		MAX
+	};
+
+	static const char* get_section_name( Section section )
+	{
+		static const char* names[] = { "input", "recording", "step", "voice", "mix", "output", "block" };
+
+		return names[ static_cast< int >( section ) ];
+	}
+
+	/**
+	 * imbPʂ̏Ԃ̃qXgO
+	 *
+	 * 2 ̗ݏ斈̋ԂX SUB_BUCKETS ɕĂ ( 1 Ԃ̕ 19% ȉ )
+	 */
+	class Histogram
+	{
+	public:
+		static const int SUB_BUCKET_BITS = 2;
+		static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+		static const int BUCKETS = 40 * SUB_BUCKETS;
+
+	private:
+		std::array< std::atomic< uint32_t >, BUCKETS > counts_;
+		std::atomic< uint64_t > count_;
+		std::atomic< uint64_t > total_;
+		std::atomic< uint64_t > max_;
+
+	public:
+		Histogram()
+		{
+			clear();
+		}
+
+		/// imb̒loPbg̔ԍ
+		static int get_bucket( uint64_t ns )
+		{
+			if ( ns < SUB_BUCKETS )
+			{
+				return static_cast< int >( ns );
+			}
+
+			int exponent = 0;
+
+			while ( ( ns >> ( exponent + 1 ) ) != 0 )
+			{
+				exponent++;
+			}
+
+			const int sub = static_cast< int >( ( ns >> ( exponent - SUB_BUCKET_BITS ) ) & ( SUB_BUCKETS - 1 ) );
+			const int bucket = ( exponent - SUB_BUCKET_BITS + 1 ) * SUB_BUCKETS + sub;
+
+			return bucket < BUCKETS ? bucket : BUCKETS - 1;
+		}
+
+		/// oPbgɓl̏ ( imb )
+		static uint64_t get_bucket_upper_bound( int bucket )
+		{
+			if ( bucket < SUB_BUCKETS )
+			{
+				return bucket + 1;
+			}
+
+			const int exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+			const uint64_t sub = bucket % SUB_BUCKETS;
+
+			return ( ( SUB_BUCKETS + sub + 1 ) << ( exponent - SUB_BUCKET_BITS ) );
+		}
+
+		void add( uint64_t ns )
+		{
+			counts_[ get_bucket( ns ) ].fetch_add( 1, std::memory_order_relaxed );
+			count_.fetch_add( 1, std::memory_order_relaxed );
+			total_.fetch_add( ns, std::memory_order_relaxed );
+
+			// ނ̂̓I[fBIXbhȂ̂ compare_exchange ͗vȂ
+			if ( ns > max_.load( std::memory_order_relaxed ) )
+			{
+				max_.store( ns, std::memory_order_relaxed );
+			}
+		}
+
+		void clear()
+		{
+			for ( auto& c : counts_ )
+			{
+				c.store( 0, std::memory_order_relaxed );
+			}
+
+			count_ = 0;
+			total_ = 0;
+			max_ = 0;
+		}
+
+		uint32_t get_bucket_count( int bucket ) const { return counts_[ bucket ].load( std::memory_order_relaxed ); }
+		uint64_t get_count() const { return count_.load( std::memory_order_relaxed ); }
+		uint64_t get_total() const { return total_.load( std::memory_order_relaxed ); }
+		uint64_t get_max() const { return max_.load( std::memory_order_relaxed ); }
+
+		double get_mean() const
+		{
+			const uint64_t count = get_count();
+
+			return count ? static_cast< double >( get_total() ) / count : 0.0;
+		}
+
+		/// percentile ( 0 .. 1 ) ̒loPbg̏ ( imb )
+		uint64_t get_percentile( double percentile ) const
+		{
+			uint64_t count = 0;
+
+			for ( int n = 0; n < BUCKETS; n++ )
+			{
+				count += get_bucket_count( n );
+			}
+
+			const uint64_t target = static_cast< uint64_t >( percentile * count );
+			uint64_t sum = 0;
+
+			for ( int n = 0; n < BUCKETS; n++ )
+			{
+				sum += get_bucket_count( n );
+
+				if ( sum > target )
+				{
+					return get_bucket_upper_bound( n );
+				}
+			}
+
+			return 0;
+		}
+	};
+
+	typedef std::chrono::steady_clock clock;
+
+private:
+	std::array< Histogram, static_cast< int >( Section::MAX ) > histograms_;
+
+	std::atomic< uint64_t > blocks_;			/// ubN̐
+	std::atomic< uint64_t > overruns_;			/// ԂubN̒𒴂ubN̐
+	std::atomic< uint64_t > late_callbacks_;	/// ÕR[obN 2 ubNȏ󂢂 ( A_[̐ )
+	std::atomic< uint64_t > deadline_ns_;		/// 1 ubN̒
+
+	std::atomic< float > gain_reduction_db_;		/// ÕubÑ~b^[̃QC_NV ( dB )
+	std::atomic< float > max_gain_reduction_db_;	/// ܂ł̍ő̃QC_NV ( dB )
+	std::atomic< uint64_t > limited_blocks_;		/// ~b^[ubN̐
+
+	// ȉ̓I[fBIXbhg
+	clock::time_point block_start_time_;
+	clock::time_point lap_time_;
+	clock::time_point last_callback_time_;
+	bool has_last_callback_ = false;
+	std::array< uint64_t, static_cast< int >( Section::MAX ) > block_time_;
+
+	static uint64_t to_ns( clock::duration d )
+	{
+		return static_cast< uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( d ).count() );
+	}
+
+public:
+	AudioProfiler()
+		: blocks_( 0 )
+		, overruns_( 0 )
+		, late_callbacks_( 0 )
+		, deadline_ns_( 0 )
+		, gain_reduction_db_( 0.f )
+		, max_gain_reduction_db_( 0.f )
+		, limited_blocks_( 0 )
+	{
+		block_time_.fill( 0 );
+	}
+
+	/// 1 ubN̒ݒ肷
+	void set_deadline( double frames_per_second, int frames_per_buffer )
+	{
+		deadline_ns_ = static_cast< uint64_t >( frames_per_buffer * 1000000000.0 / frames_per_second );
+	}
+
+	/**
+	 * I[fBIXbh : I[fBIfoCX̃R[obN̐擪ŌĂ
+	 *
+	 * foCX̃A_[ Gamma ͕Ȃ̂ŁAR[obN̊Ԋu 2 ubNȏ󂢂琔
+	 */
+	void on_callback()
+	{
+		const auto time = clock::now();
+
+		if ( has_last_callback_ && deadline_ns_ && to_ns( time - last_callback_time_ ) > deadline_ns_ * 2 )
+		{
+			late_callbacks_.fetch_add( 1, std::memory_order_relaxed );
+		}
+
+		last_callback_time_ = time;
+		has_last_callback_ = true;
+	}
+
+	/// I[fBIXbh : ubN̏n߂
+	void begin_block()
+	{
+		block_start_time_ = lap_time_ = clock::now();
+		block_time_.fill( 0 );
+	}
+
+	/// I[fBIXbh : O lap() ܂ begin_block() ̎Ԃ section ɉ
+	void lap( Section section )
+	{
+		const auto time = clock::now();
+
+		block_time_[ static_cast< int >( section ) ] += to_ns( time - lap_time_ );
+		lap_time_ = time;
+	}
+
+	/// I[fBIXbh : ubN̏I
+	void end_block()
+	{
+		const uint64_t block_time = to_ns( clock::now() - block_start_time_ );
+
+		for ( int n = 0; n < static_cast< int >( Section::BLOCK ); n++ )
+		{
+			histograms_[ n ].add( block_time_[ n ] );
+		}
+
+		histograms_[ static_cast< int >( Section::BLOCK ) ].add( block_time );
+
+		blocks_.fetch_add( 1, std::memory_order_relaxed );
+
+		if ( deadline_ns_ && block_time > deadline_ns_ )
+		{
+			overruns_.fetch_add( 1, std::memory_order_relaxed );
+		}
+	}
+
+	/// I[fBIXbh : 1 ubN̊Ԃ̃~b^[̍ŏ̃QCL^
+	void meter_gain_reduction( float min_gain )
+	{
+		const float db = min_gain < 1.f ? -20.f * std::log10( min_gain ) : 0.f;
+
+		gain_reduction_db_.store( db, std::memory_order_relaxed );
+
+		if ( db > 0.f )
+		{
+			limited_blocks_.fetch_add( 1, std::memory_order_relaxed );
+
+			if ( db > max_gain_reduction_db_.load( std::memory_order_relaxed ) )
+			{
+				max_gain_reduction_db_.store( db, std::memory_order_relaxed );
+			}
+		}
+	}
+
+	float get_gain_reduction_db() const { return gain_reduction_db_.load( std::memory_order_relaxed ); }
+	float get_max_gain_reduction_db() const { return max_gain_reduction_db_.load( std::memory_order_relaxed ); }
+	uint64_t get_limited_blocks() const { return limited_blocks_.load( std::memory_order_relaxed ); }
+
+	const Histogram& get_histogram( Section section ) const { return histograms_[ static_cast< int >( section ) ]; }
+
+	uint64_t get_blocks() const { return blocks_.load( std::memory_order_relaxed ); }
+	uint64_t get_overruns() const { return overruns_.load( std::memory_order_relaxed ); }
+	uint64_t get_late_callbacks() const { return late_callbacks_.load( std::memory_order_relaxed ); }
+	uint64_t get_deadline() const { return deadline_ns_.load( std::memory_order_relaxed ); }
+
+}; // class AudioProfiler
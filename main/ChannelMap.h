@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Config.h"
+#include "Page.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <string>
+
+/**
+ * p[gǂ̏o̓`lɏo̊蓖
+ *
+ * `l 0, 1 ͏ɃC̃~bNX ( L, R ) ŁA蓖Ăp[g͂Ƃ͕ʂ
+ * pOEfBCOE~b^[Õm̃XeƂāAw肵`lɂo͂
+ * `lɕ̃p[g蓖Ăꍇ͑킹
+ * Xe̓~b^[̐ǂ݂̕x点ďôŁAC̃~bNXƃTvPʂő
+ *
+ * Xẻʂ̓y[W̃p[g̉ʂ Mixer::STEM_GAIN ( 0.5 ) |̂ŁA
+ *  1 ̃p[g 0 dBFS ͖̉ -6 dBFSA̋Ȃōł傫 2 ( FINISH  KICK )  0 dBFS ɂȂ
+ * C̃~bNXƈ MASTER_GAIN ͊|Ȃ̂ŁAXem̉ʂ̔̓C̃~bNXƓɂȂ
+ * 킹ď𒴂́A~b^[̏ ( Limiter::DEFAULT_THRESHOLD ) ŃNbv
+ *
+ * config.txt ł "audio.channel.<p[g> <`lԍ>" Ŏw肷
+ *
+ *   audio.channel.KICK 2
+ *   audio.channel.SNARE 3
+ *   audio.channel.BASS 4
+ *
+ * I[fBIfoCX̏o̓`lɂAItC_O WAV t@C̃`lɂ蓖Ăg
+ */
+class ChannelMap
+{
+public:
+	static const int MAIN_CHANNELS = 2;		///< C̃~bNX ( L, R ) ̃`l
+	static const int MAX_CHANNELS = 32;
+
+private:
+	std::array< int, PARTS > channel_;		/// p[g̏o̓`l ( -1 ȂoȂ )
+	int channel_count_ = MAIN_CHANNELS;		/// g`l ( 蓖Ăő̃`l + 1 )
+
+public:
+	ChannelMap()
+	{
+		channel_.fill( -1 );
+	}
+
+	/**
+	 * part  channel ɏo ( -1 ȂoȂ )
+	 *
+	 * @return channel C̃`l͈͊OȂ false
+	 */
+	bool set_channel( Part part, int channel )
+	{
+		if ( channel != -1 && ( channel < MAIN_CHANNELS || channel >= MAX_CHANNELS ) )
+		{
+			return false;
+		}
+
+		channel_[ static_cast< int >( part ) ] = channel;
+
+		channel_count_ = MAIN_CHANNELS;
+
+		for ( int c : channel_ )
+		{
+			channel_count_ = std::max( channel_count_, c + 1 );
+		}
+
+		return true;
+	}
+
+	int get_channel( Part part ) const { return channel_[ static_cast< int >( part ) ]; }
+
+	/// C̃~bNX܂߂o̓`l
+	int get_channel_count() const { return channel_count_; }
+
+	/// Xeop[gȂ true
+	bool empty() const { return channel_count_ == MAIN_CHANNELS; }
+
+	/// config 犄蓖Ăǂ ( ĂȂp[g͏oȂ )
+	void load( const Config& config )
+	{
+		for ( int p = 0; p < PARTS; p++ )
+		{
+			const Part part = static_cast< Part >( p );
+			const std::string name = std::string( "audio.channel." ) + get_part_name( part );
+			const int channel = config.get( name.c_str(), -1 );
+
+			if ( ! set_channel( part, channel ) )
+			{
+				std::cout << "invalid channel : " << name << " " << channel << std::endl;
+			}
+		}
+	}
+
+}; // class ChannelMap
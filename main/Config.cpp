@@ -59,7 +59,10 @@ void Config::read_line( const std::string& line )
 		value += " ";
 	}
 
-	value.erase( value.size() - 1 );
+	if ( ! value.empty() )
+	{
+		value.erase( value.size() - 1 );
+	}
 
 	value_[ name ] = value;
 
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "spsc_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+
+/**
+ * "central" NCAgփCxg𑗐MT[o[
+ *
+ * post() ̓I[fBIXbhĂ΂̂ŁAŒ蒷̃L[ɐςނŃubNȂ
+ * io_service ̃XbhIɃL[oA܂Ƃ߂đSẴNCAg֑M
+ */
+class EventServer
+{
+public:
+	enum class Event : uint32_t
+	{
+		FIRE = 0,
+	};
+
+	/// L[ɐς 1 ̃Cxg
+	struct Record
+	{
+		Event event;
+	};
+
+	static const int QUEUE_SIZE = 256;
+	static const int DRAIN_INTERVAL_MS = 5;		///< L[oԊu
+
+private:
+	class Client
+	{
+	public:
+		boost::asio::ip::tcp::socket socket;
+
+		std::string pending;	/// M҂̃f[^
+		std::string writing;	/// M̃f[^
+
+		Client( boost::asio::io_service& io_service )
+			: socket( io_service )
+		{
+
+		}
+	};
+
+	typedef std::shared_ptr< Client > ClientPtr;
+
+	boost::asio::io_service io_service_;
+	boost::asio::ip::tcp::acceptor acceptor_;
+	boost::asio::steady_timer drain_timer_;
+
+	std::list< ClientPtr > clients_;
+	ClientPtr accepting_client_;
+
+	common::spsc_queue< Record, QUEUE_SIZE > queue_;
+	std::string batch_;
+
+	std::atomic< unsigned int > dropped_count_;		/// L[tŎ̂ĂCxg̐
+	unsigned int reported_dropped_count_ = 0;
+
+	std::thread thread_;
+
+	static void append_message( std::string& s, Event event )
+	{
+		// ]ʂI[ '\0' ܂ő
+		switch ( event )
+		{
+		case Event::FIRE:
+			s.append( "fire", sizeof( "fire" ) );
+			break;
+		}
+	}
+
+public:
+	EventServer( unsigned short port )
+		: acceptor_( io_service_, boost::asio::ip::tcp::endpoint( boost::asio::ip::tcp::v4(), port ) )
+		, drain_timer_( io_service_ )
+		, dropped_count_( 0 )
+	{
+
+	}
+
+	~EventServer()
+	{
+		stop();
+	}
+
+	void start()
+	{
+		accept();
+		drain();
+
+		thread_ = std::thread( [this] () {
+			io_service_.run();
+		} );
+	}
+
+	void stop()
+	{
+		io_service_.stop();
+
+		if ( thread_.joinable() )
+		{
+			thread_.join();
+		}
+	}
+
+	/**
+	 * Cxg𑗐ML[ɐς
+	 *
+	 * I[fBIXbhĂ΂BL[t̏ꍇ̓CxĝĂ false Ԃ
+	 */
+	bool post( Event event )
+	{
+		if ( ! queue_.push( Record { event } ) )
+		{
+			dropped_count_++;
+			return false;
+		}
+
+		return true;
+	}
+
+	unsigned int get_dropped_count() const { return dropped_count_; }
+
+protected:
+	void accept()
+	{
+		accepting_client_ = std::make_shared< Client >( io_service_ );
+
+		acceptor_.async_accept( accepting_client_->socket, [this] ( const boost::system::error_code& error ) {
+			if ( error == boost::asio::error::operation_aborted )
+			{
+				return;
+			}
+
+			if ( error )
+			{
+				std::cout << "error : " << error.message() << std::endl;
+			}
+			else
+			{
+				clients_.push_back( accepting_client_ );
+				std::cout << "central connected. ( " << clients_.size() << " )" << std::endl;
+			}
+
+			accept();
+		} );
+	}
+
+	void drain()
+	{
+		batch_.clear();
+
+		Record record;
+
+		while ( queue_.pop( record ) )
+		{
+			append_message( batch_, record.event );
+		}
+
+		if ( ! batch_.empty() )
+		{
+			if ( clients_.empty() )
+			{
+				std::cout << "central is not connected." << std::endl;
+			}
+
+			for ( const auto& client : clients_ )
+			{
+				client->pending += batch_;
+				write( client );
+			}
+		}
+
+		const unsigned int dropped_count = dropped_count_;
+
+		if ( dropped_count != reported_dropped_count_ )
+		{
+			std::cout << "dropped events : " << dropped_count << std::endl;
+			reported_dropped_count_ = dropped_count;
+		}
+
+		drain_timer_.expires_after( std::chrono::milliseconds( DRAIN_INTERVAL_MS ) );
+		drain_timer_.async_wait( [this] ( const boost::system::error_code& error ) {
+			if ( ! error )
+			{
+				drain();
+			}
+		} );
+	}
+
+	void write( const ClientPtr& client )
+	{
+		if ( ! client->writing.empty() || client->pending.empty() )
+		{
+			return;
+		}
+
+		client->writing.swap( client->pending );
+
+		boost::asio::async_write( client->socket, boost::asio::buffer( client->writing ), [this, client] ( const boost::system::error_code& error, size_t s ) {
+			client->writing.clear();
+
+			if ( error )
+			{
+				disconnect( client );
+				return;
+			}
+
+			write( client );
+		} );
+	}
+
+	void disconnect( const ClientPtr& client )
+	{
+		boost::system::error_code error;
+		client->socket.close( error );
+
+		clients_.remove( client );
+
+		std::cout << "central disconnected. ( " << clients_.size() << " )" << std::endl;
+	}
+
+}; // class EventServer
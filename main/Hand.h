@@ -3,38 +3,48 @@
 #include <boost/asio.hpp>
 
 #include "Config.h"
+#include "EventServer.h"
 
 #include "HandAudioCallback.h"
+#include "AudioProfileReporter.h"
+#include "InputThread.h"
+#include "KeyboardInput.h"
+#include "ScriptedInput.h"
 #include "LeapSoundController.h"
+#include "LeapFrameRecorder.h"
+#include "LeapFrameReplayer.h"
 
 #include <Gamma/AudioIO.h>
 
+#include <atomic>
 #include <memory>
 #include <iostream>
 #include <functional>
+#include <string>
+#include <thread>
 
 class Hand
 {
 private:
 	std::unique_ptr< HandAudioCallback > audio_callback_;
 
-	boost::asio::io_service io_service_;
-	boost::asio::ip::tcp::socket server_socket_;
-	boost::asio::ip::tcp::acceptor acceptor_;
-	bool is_central_connected_ = false;
-
-	std::thread server_thread_;
+	std::unique_ptr< EventServer > event_server_;
+	std::unique_ptr< InputThread > input_thread_;
+	std::unique_ptr< AudioProfileReporter > profile_reporter_;
 
 	Config config_;
 	LeapSoundController leap_;
 	Leap::Controller controller_;
 
+	LeapFrameRecorder recorder_;			/// LeapMotion 󂯎t[L^
+	LeapFrameReplayer replayer_;			/// LeapMotion ̑ɋL^t[Đ
+	std::thread replay_thread_;
+	std::atomic< bool > is_replaying_ = false;
+
 	std::function< void( bool, bool ) > on_step_;
 
 public:
 	Hand()
-		: server_socket_( io_service_ )
-		, acceptor_( io_service_, boost::asio::ip::tcp::endpoint( boost::asio::ip::tcp::v4(), 8080 ) )
 	{
 
 	}
@@ -68,7 +78,28 @@ public:
 			config_.set( "device.output_device_no", out );
 		}
 
-		controller_.addListener( leap_ );
+		const std::string record_file = config_.get( "leap.record_file", std::string() );
+		const std::string replay_file = config_.get( "leap.replay_file", std::string() );
+
+		if ( ! record_file.empty() && recorder_.open( record_file.c_str() ) )
+		{
+			std::cout << "record : " << record_file << std::endl;
+			leap_.set_recorder( & recorder_ );
+		}
+
+		if ( ! replay_file.empty() && replayer_.open( replay_file.c_str() ) )
+		{
+			std::cout << "replay : " << replay_file << std::endl;
+
+			is_replaying_ = true;
+			replay_thread_ = std::thread( [this] () {
+				replayer_.play( leap_, is_replaying_ );
+			} );
+		}
+		else
+		{
+			controller_.addListener( leap_ );
+		}
 
 		controller_.setPolicy( Leap::Controller::POLICY_BACKGROUND_FRAMES );
 		controller_.setPolicy( Leap::Controller::POLICY_ALLOW_PAUSE_RESUME );
@@ -78,13 +109,45 @@ public:
 
 		// std::cout << controller.config().getFloat( "Gesture.Swipe.MinLength" ) << std::endl;
 
-		audio_callback_ = std::make_unique< HandAudioCallback >( *this, in, out, leap_ );
+		ChannelMap channel_map;
+		channel_map.load( config_ );
+
+		audio_callback_ = std::make_unique< HandAudioCallback >( *this, in, out, leap_,
+			config_.get( "audio.frames_per_second", HandAudioCallback::DEFAULT_FRAMES_PER_SECOND ),
+			config_.get( "audio.frames_per_buffer", static_cast< int >( HandAudioCallback::DEFAULT_FRAMES_PER_BUFFER ) ),
+			config_.get( "audio.bpm", HandAudioCallback::DEFAULT_BPM ),
+			channel_map );
 		audio_callback_->set_mic_volume( config_.get( "hand.mic_volume", HandAudioCallback::DEFAULT_MIC_VOLUME ) );
 		audio_callback_->set_bgm_volume( config_.get( "hand.bgm_volume", HandAudioCallback::DEFAULT_BGM_VOLUME ) );
+		audio_callback_->set_block_rendering( config_.get( "audio.block_rendering", true ) );
+
+		const std::string song_file = config_.get( "song.file", std::string() );
+
+		if ( ! song_file.empty() )
+		{
+			Song song;
+
+			if ( song.load( song_file.c_str() ) )
+			{
+				audio_callback_->set_song( song );
+			}
+		}
+
+		start_input();
+
+		// profile.interval bɏԂR\[ profile.file ɏo ( 0 Ȃ珑oȂ )
+		const double profile_interval = config_.get( "profile.interval", 0.0 );
+
+		if ( profile_interval > 0.0 )
+		{
+			profile_reporter_ = std::make_unique< AudioProfileReporter >( audio_callback_->profiler(), profile_interval, config_.get( "profile.file", std::string( "profile.json" ) ) );
+			profile_reporter_->start();
+		}
 
 		if ( config_.get( "hand.server", 0 ) )
 		{
-			server_thread_ = start_server();
+			event_server_ = std::make_unique< EventServer >( static_cast< unsigned short >( config_.get( "hand.server_port", 8080 ) ) );
+			event_server_->start();
 		}
 
 		audio_callback_->start( false );
@@ -98,46 +161,87 @@ public:
 
 	void stop()
 	{
+		if ( input_thread_ )
+		{
+			input_thread_->stop();
+		}
+
+		if ( profile_reporter_ )
+		{
+			profile_reporter_->stop();
+			profile_reporter_->report();
+		}
+
 		audio_callback_->stop();
 
 		// std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
 
 		controller_.removeListener( leap_ );
 
+		is_replaying_ = false;
+
+		if ( replay_thread_.joinable() )
+		{
+			replay_thread_.join();
+		}
+
+		leap_.set_recorder( nullptr );
+		recorder_.close();
+
 		config_.set( "hand.mic_volume", audio_callback_->get_mic_volume() );
 		config_.set( "hand.bgm_volume", audio_callback_->get_bgm_volume() );
 		config_.save_file( "./config.txt" );
 
-		if ( server_thread_.joinable() )
+		if ( event_server_ )
 		{
-			server_thread_.detach();
+			event_server_->stop();
 		}
 	}
 
-	std::thread start_server()
+	/**
+	 * ̓XbhJn
+	 *
+	 * input.backend  "keyboard" ȂL[{[hA"script" Ȃ input.script_file ̃XNvgA"none" Ȃ͂Ȃ
+	 */
+	void start_input()
 	{
-		return std::thread( [this] () {
-			try
+		const std::string backend = config_.get( "input.backend", std::string( "keyboard" ) );
+
+		std::unique_ptr< InputThread::Backend > input;
+
+		if ( backend == "keyboard" )
+		{
+			input = std::make_unique< KeyboardInput >();
+		}
+		else if ( backend == "script" )
+		{
+			const std::string script_file = config_.get( "input.script_file", std::string() );
+			auto scripted_input = std::make_unique< ScriptedInput >();
+
+			if ( scripted_input->load( script_file.c_str() ) )
 			{
-				acceptor_.accept( server_socket_ );
-				is_central_connected_ = true;
+				std::cout << "input script : " << script_file << std::endl;
+				input = std::move( scripted_input );
 			}
-			catch ( std::exception e )
+			else
 			{
-				std::cout << "error : " << e.what();
+				std::cout << "could not open : " << script_file << std::endl;
 			}
-		} );
+		}
+
+		if ( input )
+		{
+			input_thread_ = std::make_unique< InputThread >( audio_callback_->input_queue(), std::move( input ) );
+			input_thread_->start();
+		}
 	}
 
+	/// I[fBIXbhĂ΂BM EventServer ̃Xbhōs
 	void send_fire()
 	{
-		if ( ! is_central_connected_ )
+		if ( event_server_ )
 		{
-			std::cout << "central is not connected." << std::endl;
-			return;
+			event_server_->post( EventServer::Event::FIRE );
 		}
-
-		size_t s = boost::asio::write( server_socket_, boost::asio::buffer( "fire" ) );
-		std::cout << "write " << s << std::endl;
 	}
 };
\ No newline at end of file
@@ -4,9 +4,20 @@
 
 #include "Tone.h"
 #include "AudioCallback.h"
+#include "ChannelMap.h"
 #include "chase_value.h"
-
-#include <windows.h>
+#include "dsp.h"
+#include "StepClock.h"
+#include "InputCommand.h"
+#include "TakeProcessor.h"
+#include "realtime_check.h"
+#include "AudioProfiler.h"
+#include "VoicePool.h"
+#include "Limiter.h"
+#include "Mixer.h"
+#include "StereoDelay.h"
+#include "SampleBank.h"
+#include "Song.h"
 
 #include <Gamma/AudioIO.h>
 #include <Gamma/Domain.h>
@@ -14,15 +25,17 @@
 #include <Gamma/Envelope.h>
 #include <Gamma/SamplePlayer.h>
 #include <Gamma/Effects.h>
-#include <Gamma/FFT.h>
-#include <Gamma/DFT.h>
 
 #include <array>
+#include <memory>
+#include <vector>
 
 class Hand;
 
 class HandAudioCallback : public AudioCallback
 {
+	friend class HandAudioCallbackBenchmark;
+
 public:
 	typedef LeapSoundController Controller;
 
@@ -33,81 +46,39 @@ public:
 	constexpr static float DEFAULT_MIC_VOLUME = 0.1f;
 	constexpr static float DEFAULT_BGM_VOLUME = 0.1f;
 
-	enum class Page
-	{
-		RPS,		// 񂯂
-		FOX,		// 1, 2, 3, tHbNX
-		TAP,		// L[^bṽf
-		PAD,		// pbh̃f
-		BASS,		// x[X̃f
-		KICK,		// LbN
-		SNARE,		// XlA
-		DEMO,		// demo
-		LEAD_R,		// [h R
-		LEAD_L,		// [h L
-		FREE,		// Rt ( i )
-		CLIMAX,		// NC}bNX
-		FINISH,		// I
-
-		MAX
-	};
+	typedef ::Page Page;
+	typedef ::Part Part;
 
-	static const int PAGES = static_cast< int >( Page::MAX );
+	float get_delay_gain() const { return page_row_.delay_gain; }
+	float get_delay_feedback() const { return page_row_.delay_feedback; }
 
-	static const std::string& get_page_name( Page page )
-	{
-		static std::array< std::string, static_cast< int >( Page::MAX ) > page_name_map = {
-			"RPS",
-			"FOX",
-			"TAP",
-			"PAD",
-			"BASS",
-			"KICK",
-			"SNARE",
-			"DEMO",
-			"LEAD_R",
-			"LEAD_L",
-			"FREE",
-			"CLIMAX",
-			"FINISH",
-		};
-
-		return page_name_map[ static_cast< int >( page ) ];
-	}
+	// BPM
+	constexpr static double DEFAULT_BPM = 120.0;
+	constexpr static double BPM_MIN = 60.0;
+	constexpr static double BPM_MAX = 200.0;
 
-	enum class Part
-	{
-		KICK = 0, SNARE, BASS, LEAD_L, LEAD_R, TAP, BRIGHT, PAD,
-		RPS, FOX,
-		MAX
-	};
+	constexpr static float DELAY_BEATS = 0.5f;			///< fBC^C (  )
+	constexpr static float MAX_DELAY_BEATS = 2.f;		///< łxe|ŊmۂĂfBC̒ (  )B^bv܂
 
-	float get_part_volume( Part part ) const
-	{
-		constexpr static float volume_table[ static_cast< int >( Part::MAX ) ][ PAGES ] = {
-		//	{ RPS, FOX,   TAP,   PAD,  BASS,  KICK, SNARE, DEMO,    R,    L,  FREE,  MAX, FIN }
-			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 1.00f, 1.00f, 1.0f, 1.0f, 1.0f, 1.00f, 1.0f, 2.f }, // KICK
-			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 0.00f, 1.00f, 1.0f, 1.0f, 1.0f, 1.00f, 1.0f, 1.f }, // SNARE
-			{ 0.f, 0.f, 0.00f, 0.00f, 0.50f, 0.50f, 0.50f, 1.0f, 1.0f, 1.0f, 1.00f, 1.0f, 0.f }, // BASS
-			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 0.00f, 0.00f, 0.0f, 0.0f, 1.0f, 0.75f, 1.0f, 0.f }, // LEAD_L
-			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 0.00f, 0.00f, 0.0f, 1.0f, 1.0f, 0.75f, 1.0f, 0.f }, // LEAD_R
-			{ 0.f, 0.f, 1.00f, 0.25f, 0.00f, 0.00f, 0.00f, 1.0f, 0.0f, 1.0f, 1.00f, 1.0f, 1.f }, // TAP
-			{ 0.f, 0.f, 0.00f, 0.00f, 0.10f, 0.10f, 0.10f, 0.1f, 0.5f, 0.5f, 1.00f, 1.0f, 1.f }, // BRIGHT
-			{ 0.f, 0.f, 0.00f, 0.25f, 0.25f, 0.25f, 0.25f, 0.5f, 0.5f, 0.5f, 0.50f, 0.5f, 0.f }, // PAD
-			{ 1.f },																			 // RPS
-			{ 0.f, 1.f },																		 // FOX
-		};
-
-		return volume_table[ static_cast< int >( part ) ][ get_page_index() ];
-	}
+	/**
+	 * ʂ⃌[gǂ鑬 ( b )
+	 *
+	 * ǂ̃TvO[głɂȂ悤ɁAinit()  1 Tv̕ωʂɒĂg
+	 * l 44.1 kHz  1 Tv 0.0001 ( 0.0005 ) ]̑ɍ킹Ă
+	 */
+	constexpr static float VOLUME_ATTACK_TIME = 0.227f;			///< ɉʂ 0  1 ɂȂ܂ł̕b
+	constexpr static float VOLUME_RELEASE_TIME = 1.134f;		///< 𗣂Ƀ[h̉ʂ 1  0 ɂȂ܂ł̕b
+	constexpr static float PORTAMENTO_TIME_L = 0.227f;			///< |^gō̃[h̃[g 1 ς܂ł̕b
+	constexpr static float PORTAMENTO_TIME_R = 0.0454f;			///< |^gŉẼ[h̃[g 1 ς܂ł̕b
 
-	// BPM
-	int get_bpm() const { return 120; }
+	double get_bpm() const { return bpm_; }
 
 public:
 	class OneShotPlayer : public gam::SamplePlayer<>
 	{
 	public:
+		using gam::SamplePlayer<>::buffer;
+
 		bool load( const char * pathToSoundFile )
 		{
 			auto result = gam::SamplePlayer<>::load( pathToSoundFile );
@@ -119,11 +90,24 @@ public:
 
 			return result;
 		}
+
+		/// ÕɂBload() ƓAɂ͖Ȃ悤ɍĐʒuI[ɒu
+		void buffer( float* src, int frames, double frame_rate, int channels )
+		{
+			gam::SamplePlayer<>::buffer( src, frames, frame_rate, channels );
+			pos( max() - 1.0 );
+		}
 	};
 
+	static constexpr const char* SAMPLE_CACHE_FILE = "samples.cache";	///< fR[hς݂̉̃LbVt@C
+
+	static const int TAP_VOICES = 16;		///< ^bv̓
+	static const int RHYTHM_VOICES = 4;		///< LbNEXlAEuCg̓
+
 private:
-	Hand& hand;
+	Hand* hand;		/// ItCŃ_Oꍇ nullptr
 	LeapSoundController& leap;
+	const Controller::Snapshot* snapshot_;	/// ubN̐擪 LeapSoundController 󂯎̏
 
 	Page page = Page::RPS;
 	
@@ -133,34 +117,63 @@ private:
 
 	bool finished = false;
 
-	gam::Accum<> timer;
+	double bpm_;
+
+	StepClock step_clock_;		/// 16 ̓𐔂
+
+	SampleBank samples_;		///  WAV t@C ( SẴvC[̃QƂ̂ŁAvC[ɐ錾 )
+
+	OneShotPlayer page_down, page_up;
 
-	OneShotPlayer tap, page_down, page_up, kick, snare;
-	gam::AD<> tap_env, kick_env, snare_env;
+	VoicePool< OneShotPlayer, TAP_VOICES > tap;			/// Œ@ĂỎ؂Ȃ悤ɏd˂Ė炷
+	VoicePool< OneShotPlayer, RHYTHM_VOICES > kick, snare;
 
 	OneShotPlayer rock_, scissors_, paper_, thumbs_up_, fox_, sound_1_, sound_2_, sound_3_;
 
 	gam::SamplePlayer < float, gam::ipl::Cubic, gam::phsInc::Loop > bass, lead_l, lead_r, pad1, pad2, pad3;
 	gam::ADSR<> bass_env;
 	
-	gam::SamplePlayer<> bright;
-	gam::AD<> bright_env;
+	VoicePool< gam::SamplePlayer<>, RHYTHM_VOICES > bright;
 
 	gam::Biquad<> bq_filter;
-	gam::Delay<> delay;
+	Mixer mixer_;				/// p[g̃oX
+	StereoDelay delay_;			/// e|ɍ킹s|fBC
 
-	common::chase_value< float > bass_volume   = common::chase_value< float >( 0.f, 0.f, 0.0001f );
-	common::chase_value< float > lead_l_volume = common::chase_value< float >( 0.f, 0.f, 0.0001f );
-	common::chase_value< float > lead_r_volume = common::chase_value< float >( 0.f, 0.f, 0.0001f );
+	Limiter limiter_;			/// oX̍Ōɒʂ~b^[
+
+	ChannelMap channel_map_;	/// p[g̃Xȅo̓`l
+	std::array< float*, ChannelMap::MAX_CHANNELS > channel_buffers_ = { };	/// onAudio() Ŏgo̓`l̃obt@
+
+	static const int STEM_DELAY_FRAMES = Limiter::MAX_LOOKAHEAD_FRAMES;		/// Xex点郊Oobt@̒ ( 2 ̗ݏ )
+	std::vector< float > stem_delay_;		/// Xẽ`l̃Oobt@ ( STEM_DELAY_FRAMES ׂ )
+	int stem_delay_write_ = 0;
+
+	//  init()  set_time_constants() ߂
+	common::chase_value< float > bass_volume   = common::chase_value< float >( 0.f, 0.f, 0.f );
+	common::chase_value< float > lead_l_volume = common::chase_value< float >( 0.f, 0.f, 0.f );
+	common::chase_value< float > lead_r_volume = common::chase_value< float >( 0.f, 0.f, 0.f );
+	common::chase_value< float > lead_l_rate   = common::chase_value< float >( 1.f, 1.f, 0.f );
+	common::chase_value< float > lead_r_rate   = common::chase_value< float >( 1.f, 1.f, 0.f );
+
+	float volume_attack_speed_;			/// VOLUME_ATTACK_TIME  1 Tv̕ωʂɒ
+	float volume_release_speed_;
+	float portamento_speed_l_;
+	float portamento_speed_r_;
+
+	bool is_portamento_l_ = true;		/// lead_l ̃[g𖈃Tvǂ邩 ( false ȂXebv̓łǂ )
+	bool is_portamento_r_ = true;		/// lead_r ̃[g𖈃Tvǂ邩
 
 	unsigned int recording_key_state_ = 0;
-	int recording_frame_index_ = 0;
+	TakeProcessor::Slot recording_slot_ = TakeProcessor::Slot::TONE;	/// ^̃eCN̎g
+
+	std::unique_ptr< TakeProcessor > takes_;	/// ^eCNH郏[J[
+	std::array< TakeProcessor::Take*, static_cast< int >( TakeProcessor::Slot::MAX ) > current_takes_ = { };	/// ݉ƂĎgĂeCN
+	bool is_capturing_ = false;				/// ^p̃obt@ɏł邩
 
-	gam::Array< float > common_tone_buffer_;
-	gam::Array< float > kick_buffer_;
-	gam::Array< float > snare_buffer_;
+	Song song_;							/// Ȃ̒`
+	Song::PageRow page_row_;			/// ݂̃y[W̋Ȃ̒` ( y[Wς song_  )
 
-	bool is_on_step_;					///  16 ̓
+	bool is_on_step_ = false;			///  16 ̓
 // 	bool is_on_beat_;					///   4 ̓
 // 	bool is_on_bar_;					/// ߂̓
 
@@ -175,72 +188,282 @@ private:
 	LeapSoundController::Hand last_step_lh_;	/// ÕXebv̍
 	LeapSoundController::Hand last_step_rh_;	/// ÕXebv̉E
 
+	InputQueue input_queue_;			/// ̓Xbh󂯎鑀
+	bool is_record_key_down_ = false;	/// ^L[Ă邩
+	bool is_speaking_ = false;			/// ׂ郂[h
+	bool is_block_rendering_ = true;	/// ubNPʂŃ_O邩 ( false ȂTvPʂ̎QƎŃ_O )
+	bool is_bgm_ducked_ = false;		/// ݂̃ubN BGM ă}CNo͂邩
+	int block_frames_ = 0;				/// ubNpobt@̃t[
+
+	std::array< std::vector< float >, static_cast< int >( Part::MAX ) > part_buffer_;	/// p[g̏o
+	std::vector< float > system_buffer_;		/// y[WύX̏o
+	std::vector< float > stereo_buffer_;		/// Sp[gvo ( C^[[uXeI )
+	std::vector< float > send_buffer_;			/// Sp[g̃fBCւ̃Zh̍v
+
+	std::vector< float > bass_volume_buffer_;	/// Tv bass_volume
+	std::vector< float > lead_l_volume_buffer_;	/// Tv lead_l_volume
+	std::vector< float > lead_r_volume_buffer_;	/// Tv lead_r_volume
+	std::vector< float > lead_l_rate_buffer_;	/// Tv lead_l ̃[g
+	std::vector< float > lead_r_rate_buffer_;	/// Tv lead_r ̃[g
+
+	std::vector< int > step_offsets_;			/// ݂̃ubÑXebv̓̈ʒu
+
+	AudioProfiler profiler_;					/// Ԃ̌v
+
 protected:
 	const LeapSoundController& get_controller() const { return leap; }
 
+	/// ݂̃ubN̎̏
+	const Controller::Snapshot& snapshot() const { return *snapshot_; }
+
 	bool is_on_step() const { return is_on_step_; }
 
+	bool is_part_active( Part part ) const { return ( page_row_.active_parts >> static_cast< int >( part ) ) & 1u; }
+
+	/// ݂̃y[W̒lȂ̒`狁߂
+	void compile_page()
+	{
+		song_.compile( page, page_row_ );
+
+		for ( int p = 0; p < PARTS; p++ )
+		{
+			const Part part = static_cast< Part >( p );
+
+			// pbh 3 ̃vC[𑫂Ă̂ŁA̕
+			const float volume = page_row_.part_volume[ p ] / ( part == Part::PAD ? 3.f : 1.f );
+
+			mixer_.set_bus( part, volume, page_row_.part_pan[ p ], page_row_.part_send[ p ] );
+		}
+
+		delay_.set_gain( page_row_.delay_gain );
+		delay_.set_feedback( page_row_.delay_feedback );
+
+		for ( int n = 0; n < StereoDelay::MAX_TAPS; n++ )
+		{
+			delay_.set_tap( n, page_row_.delay_taps[ n ] );
+		}
+	}
+
 	float get_slider_value_l( Page page ) const { return leap.l_slider( static_cast< int >( page ) ); }
 	float get_slider_value_r( Page page ) const { return leap.r_slider( static_cast< int >( page ) ); }
 	void set_slider_value_l( Page page, float value ) { leap.set_l_slider( static_cast< int >( page ), value ); }
 	void set_slider_value_r( Page page, float value ) { leap.set_r_slider( static_cast< int >( page ), value ); }
 
-	gam::Array< float >& current_recording_buffer()
+	/// ݂̃y[WŘ^eCN̎gBgȂ false Ԃ
+	bool get_take_slot( TakeProcessor::Slot& slot ) const
 	{
 		if ( page == Page::KICK )
 		{
-			return kick_buffer_;
+			slot = TakeProcessor::Slot::KICK;
+		}
+		else if ( page == Page::SNARE )
+		{
+			slot = TakeProcessor::Slot::SNARE;
+		}
+		else if ( page == Page::TAP )
+		{
+			slot = TakeProcessor::Slot::TAP;
 		}
+		else if ( page >= Page::PAD )
+		{
+			slot = TakeProcessor::Slot::TONE;
+		}
+		else
+		{
+			return false;
+		}
+
+		return true;
+	}
+
+	float* part_buffer( Part part ) { return & part_buffer_[ static_cast< int >( part ) ][ 0 ]; }
 
-		if ( page == Page::SNARE )
+	void allocate_block_buffers( int frames )
+	{
+		block_frames_ = frames;
+
+		for ( auto& b : part_buffer_ )
 		{
-			return snare_buffer_;
+			b.assign( frames, 0.f );
 		}
 
-		return common_tone_buffer_;
+		system_buffer_.assign( frames, 0.f );
+		stereo_buffer_.assign( frames * 2, 0.f );
+		send_buffer_.assign( frames, 0.f );
+
+		bass_volume_buffer_.assign( frames, 0.f );
+		lead_l_volume_buffer_.assign( frames, 0.f );
+		lead_r_volume_buffer_.assign( frames, 0.f );
+		lead_l_rate_buffer_.assign( frames, 0.f );
+		lead_r_rate_buffer_.assign( frames, 0.f );
+
+		step_offsets_.assign( frames, 0 );
 	}
 
 public:
-	HandAudioCallback( Hand& hand, int in, int out, LeapSoundController& leap )
-		: AudioCallback( in, out )
-		, hand( hand )
+	/// 1 ubN̓o
+	struct Block
+	{
+		const float* in;	///  ( }CN )
+		float* out[ 2 ];	/// o ( L, R )
+		int frames;
+		float* const* stems = nullptr;	/// o̓`l̃obt@ ( channel_map() ̃`lԍňBnullptr ȂXe͏oȂ )
+	};
+
+	HandAudioCallback( Hand& hand, int in, int out, LeapSoundController& leap,
+		double frames_per_second = DEFAULT_FRAMES_PER_SECOND, int frames_per_buffer = DEFAULT_FRAMES_PER_BUFFER, double bpm = DEFAULT_BPM,
+		const ChannelMap& channel_map = ChannelMap() )
+		: AudioCallback( in, out, frames_per_second, frames_per_buffer, channel_map.get_channel_count() )
+		, hand( & hand )
 		, leap( leap )
-		, tap_env( 0.01f, 1.0f )
-		, kick_env( 0.01f, 0.25f )
-		, snare_env( 0.01f, 0.25f )
+		, snapshot_( & leap.read_snapshot() )
+		, bpm_( math::clamp( bpm, BPM_MIN, BPM_MAX ) )
+		, tap( 0.01f, 1.0f )
+		, kick( 0.01f, 0.25f )
+		, snare( 0.01f, 0.25f )
 		, bass_env( 0.01f )
+		, bright( 0.01f, 0.1f )
+		, channel_map_( channel_map )
 	{
-		timer.period( 60.f / get_bpm() / 4.f );
-		timer.phaseMax();
+		if ( audioIO().channelsOut() < channel_map_.get_channel_count() )
+		{
+			std::cout << "output device has only " << audioIO().channelsOut() << " channels. stems are disabled." << std::endl;
+		}
+
+		init();
 
-		page_down.load( "page_down.wav" );
-		page_up.load( "page_up.wav" );
-		tap.load( "tap.wav" );
+		takes_->start();
+	}
 
-		kick.load( "kick.wav" );
-		snare.buffer( kick );
+	/// I[fBIfoCXg킸 process() Ń_Oꍇ̃RXgN^
+	HandAudioCallback( LeapSoundController& leap, double frames_per_second, int frames_per_buffer, double bpm = DEFAULT_BPM,
+		const ChannelMap& channel_map = ChannelMap() )
+		: AudioCallback( Offline(), frames_per_second, frames_per_buffer )
+		, hand( nullptr )
+		, leap( leap )
+		, snapshot_( & leap.read_snapshot() )
+		, bpm_( math::clamp( bpm, BPM_MIN, BPM_MAX ) )
+		, tap( 0.01f, 1.0f )
+		, kick( 0.01f, 0.25f )
+		, snare( 0.01f, 0.25f )
+		, bass_env( 0.01f )
+		, bright( 0.01f, 0.1f )
+		, channel_map_( channel_map )
+	{
+		init();
 
-		bass.load( "a.wav" );
-		lead_l.buffer( bass );
-		lead_r.buffer( bass );
+		// eCN̓[J[Xbhg킸 flush_takes() ŉH
+	}
 
-		delay.maxDelay( 1.5f );
-		delay.delay( 60.f / get_bpm() / 2.f );
+	void init()
+	{
+		profiler_.set_deadline( get_frames_per_second(), get_frames_per_buffer() );
+
+		// Oobt@͍łxe| 4 mۂĂAe|ςĂ蒼Ȃ
+		takes_ = std::make_unique< TakeProcessor >( static_cast< int >( get_frames_per_second() * 60 / BPM_MIN ) * 4, get_frames_per_second() );
+
+		load_samples();
+
+		set_time_constants();
+
+		delay_.set_frames_per_second( get_frames_per_second(), 60.0 / BPM_MIN * MAX_DELAY_BEATS );
+		delay_.set_beats( DELAY_BEATS );
+
+		set_bpm( bpm_ );
 
 		bq_filter.type( gam::HIGH_PASS );
 
 		set_slider_value_r( Page::KICK,  tone_rate_to_rate( 1.f, RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
 		set_slider_value_r( Page::SNARE, tone_rate_to_rate( 1.f, RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
 
-		rock_.load( "rock.wav" );
-		scissors_.load( "scissors.wav" );
-		paper_.load( "paper.wav" );
-		thumbs_up_.load( "thumbs_up.wav" );
-		fox_.load( "fox.wav" );
+		compile_page();
+		delay_.fit();
+
+		allocate_block_buffers( get_frames_per_buffer() );
 
-		sound_1_.load( "1.wav" );
-		sound_2_.load( "2.wav" );
-		sound_3_.load( "3.wav" );
+		stem_delay_.assign( static_cast< size_t >( channel_map_.get_channel_count() - ChannelMap::MAIN_CHANNELS ) * STEM_DELAY_FRAMES, 0.f );
+	}
+
+	/// bŌ߂ 1 Tv̕ωʂ߂
+	float get_speed_per_frame( float seconds ) const
+	{
+		return static_cast< float >( 1.0 / ( seconds * get_frames_per_second() ) );
+	}
+
+	/// ԂŌ߂p[^[TvO[gɍ킹 1 Tv̒lɒ
+	void set_time_constants()
+	{
+		volume_attack_speed_ = get_speed_per_frame( VOLUME_ATTACK_TIME );
+		volume_release_speed_ = get_speed_per_frame( VOLUME_RELEASE_TIME );
+		portamento_speed_l_ = get_speed_per_frame( PORTAMENTO_TIME_L );
+		portamento_speed_r_ = get_speed_per_frame( PORTAMENTO_TIME_R );
+
+		bass_volume.speed() = volume_attack_speed_;
+		limiter_.set_frames_per_second( get_frames_per_second() );
+
+		tap.set_frames_per_second( get_frames_per_second() );
+		kick.set_frames_per_second( get_frames_per_second() );
+		snare.set_frames_per_second( get_frames_per_second() );
+		bright.set_frames_per_second( get_frames_per_second() );
+	}
+
+	/**
+	 *  WAV t@C SampleBank ł܂Ƃ߂ēǂݍ݁AvC[Ɋ蓖Ă
+	 *
+	 * t@CgvC[ ( kick  snareAbass  lead Ȃ ) ͓QƂ
+	 */
+	void load_samples()
+	{
+		for ( const char* path : { "page_down.wav", "page_up.wav", "tap.wav", "kick.wav", "a.wav",
+			"rock.wav", "scissors.wav", "paper.wav", "thumbs_up.wav", "fox.wav", "1.wav", "2.wav", "3.wav" } )
+		{
+			samples_.add( path );
+		}
+
+		samples_.load( SAMPLE_CACHE_FILE );
+
+		SampleBank::assign( page_down, samples_.get( "page_down.wav" ) );
+		SampleBank::assign( page_up, samples_.get( "page_up.wav" ) );
+		SampleBank::assign( tap, samples_.get( "tap.wav" ) );
+
+		SampleBank::assign( kick, samples_.get( "kick.wav" ) );
+		SampleBank::assign( snare, samples_.get( "kick.wav" ) );
+
+		SampleBank::assign( bass, samples_.get( "a.wav" ) );
+		SampleBank::assign( lead_l, samples_.get( "a.wav" ) );
+		SampleBank::assign( lead_r, samples_.get( "a.wav" ) );
+
+		SampleBank::assign( rock_, samples_.get( "rock.wav" ) );
+		SampleBank::assign( scissors_, samples_.get( "scissors.wav" ) );
+		SampleBank::assign( paper_, samples_.get( "paper.wav" ) );
+		SampleBank::assign( thumbs_up_, samples_.get( "thumbs_up.wav" ) );
+		SampleBank::assign( fox_, samples_.get( "fox.wav" ) );
+
+		SampleBank::assign( sound_1_, samples_.get( "1.wav" ) );
+		SampleBank::assign( sound_2_, samples_.get( "2.wav" ) );
+		SampleBank::assign( sound_3_, samples_.get( "3.wav" ) );
+	}
+
+	/**
+	 * e|ς ( I[fBIXbhAstart() ̑OɌĂ )
+	 *
+	 * ̃Xebv̈ʒu͂̂܂܂ŁA̎̃XebvVe|Ő
+	 * fBC^C StereoDelay::TIME_SPEED ŐVl܂ňڂ̂ŁAe|ςĂv`mCY͏oȂ
+	 */
+	void set_bpm( double bpm )
+	{
+		bpm_ = math::clamp( bpm, BPM_MIN, BPM_MAX );
+
+		step_clock_.set_frames_per_step( get_frames_per_second() * 60.0 / bpm_ / 4.0 );
+		delay_.set_bpm( bpm_ );
+		takes_->set_take_frames( get_frames_per_beat() * 4 );
+	}
+
+	/// Ȃւ ( I[fBIJnOɌĂԂ )
+	void set_song( const Song& song )
+	{
+		song_ = song;
+		compile_page();
 	}
 
 	Page get_page() const { return page; }
@@ -259,6 +482,20 @@ public:
 	void set_mic_volume( float v ) { mic_volume_ = math::clamp( v, 0.f, 1.f ); }
 	void set_bgm_volume( float v ) { bgm_volume_ = math::clamp( v, 0.f, 1.f ); }
 
+	/// ̓XbhςރL[
+	InputQueue& input_queue() { return input_queue_; }
+
+	/// Ԃ̌v ( ̃Xbhǂł悢 )
+	const AudioProfiler& profiler() const { return profiler_; }
+
+	const ChannelMap& channel_map() const { return channel_map_; }
+
+	/// ItC_Op : process() ̌ɌĂсA^IeCN̏ŉH
+	void flush_takes() { takes_->flush(); }
+
+	bool is_block_rendering() const { return is_block_rendering_; }
+	void set_block_rendering( bool b ) { is_block_rendering_ = b; }
+
 	bool is_recording() const
 	{
 		return recording_key_state_ & 0b1;
@@ -266,7 +503,7 @@ public:
 
 	bool is_speaking_mode() const
 	{
-		return GetAsyncKeyState( VK_SPACE ) & 0b1000000000000000;
+		return is_speaking_;
 	}
 
 	bool is_record_started() const
@@ -296,17 +533,17 @@ public:
 
 	static float rate_to_tone_rate( float value, float min, float max )
 	{
-		const float log2_min = std::log2f( min );
-		const float log2_max = std::log2f( max );
+		const float log2_min = std::log2( min );
+		const float log2_max = std::log2( max );
 
-		return math::clamp( std::powf( 2.f, ( log2_max - log2_min ) * value + log2_min ), min, max );
+		return math::clamp( std::pow( 2.f, ( log2_max - log2_min ) * value + log2_min ), min, max );
 	}
 
 	static float tone_rate_to_rate( float value, float min, float max )
 	{
-		const float log2_min = std::log2f( min );
-		const float log2_max = std::log2f( max );
-		const float log2_value = std::log2f( value );
+		const float log2_min = std::log2( min );
+		const float log2_max = std::log2( max );
+		const float log2_value = std::log2( value );
 
 		return math::clamp( ( log2_value - log2_min ) / ( log2_max - log2_min ), 0.f, 1.f );
 	}
@@ -316,291 +553,701 @@ public:
 		return rate_to_range( range_to_rate( value, min, max ), new_min, new_max );
 	}
 
-	void key_input()
+	/// ̓Xbh󂯎Kp
+	void apply_input( const InputCommand& command )
 	{
-		if ( GetAsyncKeyState( VK_LEFT ) & 0b1000000000000000 )
+		switch ( command.type )
 		{
-			leap.decrement_page();
+		case InputCommand::Type::PAGE_DOWN:			leap.decrement_page(); break;
+		case InputCommand::Type::PAGE_UP:			leap.increment_page(); break;
+		case InputCommand::Type::MOVE_L_SLIDER:		leap.move_l_slider_force( command.value ); break;
+		case InputCommand::Type::MOVE_R_SLIDER:		leap.move_r_slider_force( command.value ); break;
+		case InputCommand::Type::MOVE_MIC_VOLUME:	set_mic_volume( mic_volume_ + command.value ); break;
+		case InputCommand::Type::MOVE_BGM_VOLUME:	set_bgm_volume( bgm_volume_ + command.value ); break;
+		case InputCommand::Type::RECORD_START:		is_record_key_down_ = true; break;
+		case InputCommand::Type::RECORD_STOP:		is_record_key_down_ = false; break;
+		case InputCommand::Type::SPEAK_START:		is_speaking_ = true; break;
+		case InputCommand::Type::SPEAK_STOP:		is_speaking_ = false; break;
+		case InputCommand::Type::MOVE_BPM:			set_bpm( bpm_ + command.value ); break;
+		case InputCommand::Type::SET_BPM:			set_bpm( command.value ); break;
 		}
-		if ( GetAsyncKeyState( VK_RIGHT ) & 0b1000000000000000 )
+	}
+
+	/**
+	 * ubN̐擪œ͂
+	 *
+	 * ̓foCX InputThread ǂނ̂ŁAł̓L[ɗ܂Kp邾
+	 */
+	void process_input()
+	{
+		InputCommand command;
+
+		while ( input_queue_.pop( command ) )
 		{
-			leap.increment_page();
+			apply_input( command );
 		}
 
-		const float speed = 0.02f;
+		recording_key_state_ <<= 1;
+		recording_key_state_ |= is_record_key_down_;
 
-		if ( GetAsyncKeyState( VK_NUMPAD1 ) & 0b1000000000000000 )
+		if ( is_record_started() )
 		{
-			leap.move_l_slider_force( -speed );
+			// eCN̎g͘^n߂̃y[WŌ߂
+			is_capturing_ = get_take_slot( recording_slot_ ) && takes_->begin_capture();
 		}
-		if ( GetAsyncKeyState( VK_NUMPAD7 ) & 0b1000000000000000 )
+		else if ( is_record_finished() )
 		{
-			leap.move_l_slider_force( +speed );
+			if ( is_capturing_ )
+			{
+				takes_->submit( recording_slot_ );
+			}
+
+			is_capturing_ = false;
 		}
-		if ( GetAsyncKeyState( VK_NUMPAD3 ) & 0b1000000000000000 )
+
+		// std::cout << recording_key_state_ << std::endl;
+	}
+
+	/**
+	 * [J[HIeCNɍւ
+	 *
+	 * Xebv̓ŌĂ΂BւÂeCN̉̓[J[ɔC
+	 */
+	void apply_takes()
+	{
+		while ( TakeProcessor::Take* take = takes_->poll() )
 		{
-			leap.move_r_slider_force( -speed );
+			float* samples = & take->samples[ 0 ];
+			const int frames = static_cast< int >( take->samples.size() );
+			const double rate = get_frames_per_second();
+
+			switch ( take->slot )
+			{
+			case TakeProcessor::Slot::KICK:
+				kick.buffer( samples, frames, rate, 1 );
+				set_slider_value_r( Page::KICK, tone_rate_to_rate( 1.f, RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
+				break;
+			case TakeProcessor::Slot::SNARE:
+				snare.buffer( samples, frames, rate, 1 );
+				set_slider_value_r( Page::SNARE, tone_rate_to_rate( 1.f, RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
+				break;
+			case TakeProcessor::Slot::TAP:
+				tap.buffer( samples, frames, rate, 1 );
+				break;
+			case TakeProcessor::Slot::TONE:
+			{
+				// o C3 ɂȂ悤ɃTvO[g炵ēn
+				const double tone_rate = rate * take->tuning;
+
+				// [vvC[̓[J[[v_̊Ԃ
+				for ( auto* player : { & bass, & lead_l, & lead_r, & pad1, & pad2, & pad3 } )
+				{
+					player->buffer( samples, frames, tone_rate, 1 );
+					player->max( take->loop_end );
+					player->min( take->loop_begin );
+					player->pos( take->loop_begin );
+				}
+
+				for ( auto* voices : { & kick, & snare } )
+				{
+					voices->buffer( samples, frames, tone_rate, 1 );
+				}
+
+				bright.buffer( samples, frames, tone_rate, 1 );
+				break;
+			}
+			default:
+				break;
+			}
+
+			auto& current = current_takes_[ static_cast< int >( take->slot ) ];
+
+			takes_->retire( current );
+			current = take;
+
+			// TONE  KICK  SNARE ̉ւ̂ŁA܂ł̃eCN͂QƂȂ
+			if ( take->slot == TakeProcessor::Slot::TONE )
+			{
+				for ( auto slot : { TakeProcessor::Slot::KICK, TakeProcessor::Slot::SNARE } )
+				{
+					takes_->retire( current_takes_[ static_cast< int >( slot ) ] );
+					current_takes_[ static_cast< int >( slot ) ] = nullptr;
+				}
+			}
 		}
-		if ( GetAsyncKeyState( VK_NUMPAD9 ) & 0b1000000000000000 )
+	}
+
+	void print_edge( gam::Array<float>& buf ) const
+	{
+		std::cout << "edge :" << std::endl;
+
+		for ( int n = -5; n <= 5; n++ )
 		{
-			leap.move_r_slider_force( +speed );
+			std::cout << n << ": " << buf[ ( buf.size() + n ) % buf.size() ] << std::endl;
 		}
+	}
+
+	void onAudio( gam::AudioIOData& io )
+	{
+		profiler_.on_callback();
 
-		if ( GetAsyncKeyState( 'Z' ) & 0b1000000000000000 )
+		Block block = { io.inBuffer( 0 ), { io.outBuffer( 0 ), io.outBuffer( 1 ) }, io.framesPerBuffer() };
+
+		// foCX̃`lȂ΃Xe͏oȂ
+		if ( ! channel_map_.empty() && io.channelsOut() >= channel_map_.get_channel_count() )
 		{
-			set_mic_volume( mic_volume_ - 0.001f );
+			for ( int c = 0; c < channel_map_.get_channel_count(); c++ )
+			{
+				channel_buffers_[ c ] = io.outBuffer( c );
+			}
+
+			block.stems = & channel_buffers_[ 0 ];
 		}
-		if ( GetAsyncKeyState( 'X' ) & 0b1000000000000000 )
+
+		process( block );
+	}
+
+	/**
+	 * 1 ubN̏
+	 *
+	 * I[fBIfoCX onAudio() oRŁAItC_Oł͒ڌĂ΂
+	 */
+	void process( const Block& block )
+	{
+		common::realtime_scope realtime;
+
+		profiler_.begin_block();
+
+		snapshot_ = & leap.read_snapshot();
+
+		process_input();
+
+		profiler_.lap( AudioProfiler::Section::INPUT );
+
+		if ( is_recording() && is_capturing_ )
 		{
-			set_mic_volume( mic_volume_ + 0.001f );
+			takes_->capture( block.in, block.frames );
 		}
 
-		if ( GetAsyncKeyState( 'C' ) & 0b1000000000000000 )
+		profiler_.lap( AudioProfiler::Section::RECORDING );
+
+		if ( is_block_rendering_ && block.frames <= block_frames_ )
 		{
-			set_bgm_volume( get_bgm_volume() - 0.001f );
+			render_block( block );
 		}
-		if ( GetAsyncKeyState( 'V' ) & 0b1000000000000000 )
+		else
 		{
-			set_bgm_volume( get_bgm_volume() + 0.001f );
+			render_reference( block );
+
+			// QƎ͋ԂɕȂ̂ŁAŜ VOICE ƂČv
+			profiler_.lap( AudioProfiler::Section::VOICE );
 		}
 
-		recording_key_state_ <<= 1;
-		recording_key_state_ |= static_cast< bool >( GetAsyncKeyState( 'R' ) & 0b1000000000000000 );
+		profiler_.meter_gain_reduction( limiter_.take_min_gain() );
+		profiler_.end_block();
+	}
 
-		if ( is_record_started() )
+	/**
+	 * TvPʂŃ_OQƎ
+	 *
+	 * render_block() ̌ʂ 1 Tvr邽߂ɎcĂ
+	 */
+	void render_reference( const Block& block )
+	{
+		for ( int n = 0; n < block.frames; n++ )
 		{
-			recording_frame_index_ = 0;
-			current_recording_buffer().resize( get_frames_per_beat() * 4, 0 );
+			is_on_step_ = false;
+			// is_on_beat_ = false;
+			// is_on_bar_  = false;
+
+			if ( step_clock_.tick() )
+			{
+				on_timer();
+			}
+
+			update_bass();
+			update_lead();
+
+			mix( block, n );
 		}
-		else if ( is_record_finished() )
+	}
+
+	/**
+	 * ubNPʂŃ_O
+	 *
+	 * ep[g framesPerBuffer ܂Ƃ߂ part_buffer_ ɏoAQC|ȂoXɍv
+	 * Xebv̏ŉ̏Ԃς̂ŁAStepClock ŋ߂Xebv̓ŃubN𕪊A
+	 * Ԃ̊ԂŃXebv̏s
+	 */
+	void render_block( const Block& block )
+	{
+		const int frames = block.frames;
+
+		is_bgm_ducked_ = is_recording() || is_speaking_mode();
+
+		const int steps = step_clock_.split( frames, & step_offsets_[ 0 ] );
+
+		int begin = 0;
+
+		for ( int i = 0; i <= steps; i++ )
 		{
-			current_recording_buffer().resize( std::max( recording_frame_index_, 64 ) );
-			
-			// analysis( rec_buf );
-			// print_edge( rec_buf );
+			const int end = i < steps ? step_offsets_[ i ] : frames;
 
-			gam::arr::normalize( & current_recording_buffer()[ 0 ], current_recording_buffer().size() );
+			update_control( begin, end );
 
-			if ( page == Page::KICK )
-			{
-				kick.buffer( kick_buffer_, audioIO().framesPerSecond(), 1 );
-				set_slider_value_r( Page::KICK, tone_rate_to_rate( 1.f, RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
-			}
-			else if ( page == Page::SNARE )
-			{
-				snare.buffer( snare_buffer_, audioIO().framesPerSecond(), 1 );
-				set_slider_value_r( Page::SNARE, tone_rate_to_rate( 1.f, RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
-			}
-			else if ( page == Page::TAP )
-			{
-				tap.buffer( common_tone_buffer_, audioIO().framesPerSecond(), 1 );
-			}
-			else
+			profiler_.lap( AudioProfiler::Section::STEP );
+
+			render_segment( block, begin, end );
+
+			if ( i < steps )
 			{
-				if ( page >= Page::PAD )
-				{
-					smoothing( common_tone_buffer_ );
-					// print_edge( rec_buf );
-
-					bass.buffer( common_tone_buffer_, audioIO().framesPerSecond(), 1 );
-					lead_l.buffer( bass );
-					lead_r.buffer( bass );
-					pad1.buffer( bass );
-					pad2.buffer( bass );
-					pad3.buffer( bass );
-
-					kick.buffer( common_tone_buffer_, audioIO().framesPerSecond(), 1 );
-					snare.buffer( kick );
-					bright.buffer( kick );
-				}
+				on_timer();
+
+				profiler_.lap( AudioProfiler::Section::STEP );
 			}
+
+			begin = end;
 		}
+	}
 
-		// std::cout << recording_key_state_ << std::endl;
+	/**
+	 * [ begin, end ) ͈̔͂̃x[Xƃ[h̉ʂƃ[g߂
+	 *
+	 * ԓł͎̏Ԃy[WςȂ̂ŁAڕWlƑxx߂ĂԑŜ̃v܂Ƃ߂ďo
+	 * Xebv̓̋Ԃł́A|^gȂ[hŏ̃Tvł[gǂ
+	 */
+	void update_control( int begin, int end )
+	{
+		const int frames = end - begin;
+
+		if ( frames <= 0 )
+		{
+			return;
+		}
+
+		update_bass_target();
+		update_lead_target();
+
+		if ( page == Page::BASS )
+		{
+			bass_volume.chase( & bass_volume_buffer_[ begin ], frames );
+		}
+		else
+		{
+			dsp::fill( & bass_volume_buffer_[ begin ], bass_volume.value(), frames );
+		}
+
+		update_lead_rate( lead_l_rate, is_portamento_l_, & lead_l_rate_buffer_[ begin ], frames );
+		update_lead_rate( lead_r_rate, is_portamento_r_, & lead_r_rate_buffer_[ begin ], frames );
+
+		lead_l_volume.chase( & lead_l_volume_buffer_[ begin ], frames );
+		lead_r_volume.chase( & lead_r_volume_buffer_[ begin ], frames );
+
+		is_on_step_ = false;
 	}
 
-	void smoothing( gam::Array<float>& buf )
+	void update_lead_rate( common::chase_value< float >& rate, bool is_portamento, float* out, int frames )
 	{
-		if ( false )
+		if ( is_portamento )
 		{
-			const float range = 16;
+			rate.chase( out, frames );
+		}
+		else if ( is_on_step() )
+		{
+			rate.chase( out, 1 );
+			dsp::fill( out + 1, rate.value(), frames - 1 );
+		}
+		else
+		{
+			dsp::fill( out, rate.value(), frames );
+		}
+	}
 
-			for ( int n = 0; n < buf.size(); n++ )
-			{
-				float v = 0.f;
+	void on_timer()
+	{
+		apply_takes();
 
-				for ( int m = 0; m < range; m++ )
-				{
-					v += buf[ ( n + m ) % buf.size() ];
-				}
+		current_step_lh_ = snapshot().lh;
+		current_step_rh_ = snapshot().rh;
 
-				buf[ n ] = v / range;
-			}
+		on_note();
+
+		last_step_lh_ = current_step_lh_;
+		last_step_rh_ = current_step_rh_;
+	}
+
+	/// I̓_OɖƂ
+	template< typename Player >
+	static void render_player( Player& player, float* out, int frames )
+	{
+		if ( player.done() )
+		{
+			dsp::clear( out, frames );
+			return;
 		}
 
-		if ( true )
+		for ( int n = 0; n < frames; n++ )
 		{
-			for ( int n = 0; n < buf.size() / 2; n++ )
-			{
-				int m = buf.size() / 2 + n;
+			out[ n ] = player();
+		}
+	}
 
-				float r = static_cast< float >( n ) / ( buf.size() / 2 );
-				float a = buf[ n ];
-				float b = buf[ m ];
+	template< typename Player >
+	static void render_player_add( Player& player, float* out, int frames )
+	{
+		if ( player.done() )
+		{
+			return;
+		}
 
-				buf[ n ] = ( a * r ) + ( b * ( 1.f - r ) );
-				buf[ m ] = ( a * r ) + ( b * ( 1.f - r ) );
-			}
+		for ( int n = 0; n < frames; n++ )
+		{
+			out[ n ] += player();
 		}
 	}
 
-	void sine( gam::Array<float>& buf, float tone )
+	/**
+	 * _OɃ[vĐ̈ʒui߂
+	 *
+	 * rate_frames ͐i߂Tṽ[g̍v ( [gȂ frames * rate() )
+	 */
+	template< typename T, typename Sipl >
+	void skip_player( gam::SamplePlayer< T, Sipl, gam::phsInc::Loop >& player, double rate_frames ) const
 	{
-		gam::Sine<> s;
-		s.freq( tone );
+		const double length = player.max() - player.min();
+
+		if ( length <= 0.0 )
+		{
+			return;
+		}
 
-		buf.resize( audioIO().framesPerSecond() );
+		double pos = std::fmod( player.pos() - player.min() + rate_frames * player.frameRate() / get_frames_per_second(), length );
 
-		for ( auto n = 0; n < buf.size(); n++ )
+		if ( pos < 0.0 )
 		{
-			buf[ n ] = s();
+			pos += length;
 		}
+
+		player.pos( player.min() + pos );
 	}
 
-	void analysis( gam::Array<float>& buf )
+	/// _OɃVbgĐ̈ʒui߂
+	template< typename T, typename Sipl >
+	void skip_player( gam::SamplePlayer< T, Sipl, gam::phsInc::OneShot >& player, double rate_frames ) const
 	{
-		gam::RFFT<float> rfft( buf.size() );
-		
-		rfft.forward( &buf[ 0 ] );
+		if ( ! player.done() )
+		{
+			player.pos( std::min( player.pos() + rate_frames * player.frameRate() / get_frames_per_second(), player.max() ) );
+		}
+	}
+
+	template< typename Player, typename Envelope >
+	static void render_player( Player& player, Envelope& envelope, float* out, int frames )
+	{
+		for ( int n = 0; n < frames; n++ )
+		{
+			out[ n ] = player() * envelope();
+		}
+	}
+
+	template< typename Player >
+	static void render_player( Player& player, const float* rate, const float* volume, float* out, int frames )
+	{
+		for ( int n = 0; n < frames; n++ )
+		{
+			player.rate( rate[ n ] );
+			out[ n ] = player() * volume[ n ];
+		}
+	}
 
-		// std::cout << std::endl;
+	template< typename Envelope >
+	static void skip_envelope( Envelope& envelope, int frames )
+	{
+		for ( int n = 0; n < frames; n++ )
+		{
+			envelope();
+		}
+	}
 
-		float max = 0.f;
-		float freq = 0.f;
+	/**
+	 * [ begin, end ) ͈̔͂̊ep[g part_buffer_ Ƀ_O
+	 *
+	 * ݂̃y[Wŉʂ 0 ̃p[g̓_OAĐʒuƃGx[vi߂
+	 * ( part_buffer_ ͏Ȃ̂ŁA~bNXłgȂ )
+	 * IVbg̉ƃ{CX̓_OȂ
+	 */
+	void render_voices( int begin, int end )
+	{
+		const int frames = end - begin;
+		const double frames_per_second = get_frames_per_second();
 
-		for ( auto n = 1; n < buf.size(); n += 2 )
+		if ( is_part_active( Part::KICK ) )
 		{
-			const float f = static_cast< float >( n ) * static_cast< float >( audioIO().framesPerSecond() ) / buf.size();
+			kick.render( part_buffer( Part::KICK ) + begin, frames );
+		}
+		else
+		{
+			kick.skip( frames, frames_per_second );
+		}
 
-			if ( max < buf[ n ] )
-			{
-				max = buf[ n ];
-				freq = f;
-			}
+		if ( is_part_active( Part::SNARE ) )
+		{
+			snare.render( part_buffer( Part::SNARE ) + begin, frames );
+		}
+		else
+		{
+			snare.skip( frames, frames_per_second );
+		}
 
-			if ( f >= 200 && f <= 500 )
-			{
-				std::cout << "f : " << f << " : " << buf[ n ] << std::endl;
-			}
+		if ( is_part_active( Part::BASS ) )
+		{
+			render_player( bass, bass_env, part_buffer( Part::BASS ) + begin, frames );
+			dsp::mul( part_buffer( Part::BASS ) + begin, & bass_volume_buffer_[ begin ], frames );
+		}
+		else
+		{
+			skip_player( bass, frames * bass.rate() );
+			skip_envelope( bass_env, frames );
+		}
 
-			// std::cout << buf[ n ] << "," << buf[ n + 1 ] << std::endl;
+		if ( is_part_active( Part::LEAD_L ) )
+		{
+			render_player( lead_l, & lead_l_rate_buffer_[ begin ], & lead_l_volume_buffer_[ begin ], part_buffer( Part::LEAD_L ) + begin, frames );
+		}
+		else
+		{
+			skip_player( lead_l, dsp::sum( & lead_l_rate_buffer_[ begin ], frames ) );
+			lead_l.rate( lead_l_rate_buffer_[ end - 1 ] );
 		}
 
-		std::cout << "freq: " << freq << std::endl;
+		if ( is_part_active( Part::LEAD_R ) )
+		{
+			render_player( lead_r, & lead_r_rate_buffer_[ begin ], & lead_r_volume_buffer_[ begin ], part_buffer( Part::LEAD_R ) + begin, frames );
+		}
+		else
+		{
+			skip_player( lead_r, dsp::sum( & lead_r_rate_buffer_[ begin ], frames ) );
+			lead_r.rate( lead_r_rate_buffer_[ end - 1 ] );
+		}
 
-		rfft.inverse( &buf[ 0 ] );
+		if ( is_part_active( Part::TAP ) )
+		{
+			tap.render( part_buffer( Part::TAP ) + begin, frames );
+		}
+		else
+		{
+			tap.skip( frames, frames_per_second );
+		}
+
+		if ( is_part_active( Part::RPS ) )
+		{
+			render_player( rock_, part_buffer( Part::RPS ) + begin, frames );
+			render_player_add( paper_, part_buffer( Part::RPS ) + begin, frames );
+			render_player_add( scissors_, part_buffer( Part::RPS ) + begin, frames );
+			render_player_add( thumbs_up_, part_buffer( Part::RPS ) + begin, frames );
+		}
+		else
+		{
+			for ( auto* player : { & rock_, & paper_, & scissors_, & thumbs_up_ } )
+			{
+				skip_player( *player, frames * player->rate() );
+			}
+		}
 
-		/*
-		gam::STFT stft;
+		if ( is_part_active( Part::FOX ) )
+		{
+			render_player( sound_1_, part_buffer( Part::FOX ) + begin, frames );
+			render_player_add( sound_2_, part_buffer( Part::FOX ) + begin, frames );
+			render_player_add( sound_3_, part_buffer( Part::FOX ) + begin, frames );
+			render_player_add( fox_, part_buffer( Part::FOX ) + begin, frames );
+		}
+		else
+		{
+			for ( auto* player : { & sound_1_, & sound_2_, & sound_3_, & fox_ } )
+			{
+				skip_player( *player, frames * player->rate() );
+			}
+		}
 
-		if ( stft( buf[ 0 ] ) )
+		if ( is_part_active( Part::PAD ) )
+		{
+			render_player( pad1, part_buffer( Part::PAD ) + begin, frames );
+			render_player_add( pad2, part_buffer( Part::PAD ) + begin, frames );
+			render_player_add( pad3, part_buffer( Part::PAD ) + begin, frames );
+		}
+		else
 		{
-			for ( int n = 0; n < stft.numBins(); n++ )
+			for ( auto* player : { & pad1, & pad2, & pad3 } )
 			{
-				stft.bin( n );
+				skip_player( *player, frames * player->rate() );
 			}
 		}
 
-		std::cout << "num bins: " << stft.numBins() << std::endl;
-		std::cout << "bin freq: " << stft.binFreq() << std::endl;
-		*/
+		if ( is_part_active( Part::BRIGHT ) )
+		{
+			bright.render( part_buffer( Part::BRIGHT ) + begin, frames );
+		}
+		else
+		{
+			bright.skip( frames, frames_per_second );
+		}
+
+		// y[WύX͂ǂ̃y[Wł炷
+		render_player( page_down, & system_buffer_[ begin ], frames );
+		render_player_add( page_up, & system_buffer_[ begin ], frames );
 	}
 
-	void print_edge( gam::Array<float>& buf ) const
+	/**
+	 * [ begin, end ) ͈̔͂_O
+	 *
+	 * ͈͓ł̓y[WςȂ̂ŁAp[g̃QC͒萔ƂĈ
+	 */
+	void render_segment( const Block& block, int begin, int end )
 	{
-		std::cout << "edge :" << std::endl;
+		const int frames = end - begin;
 
-		for ( int n = -5; n <= 5; n++ )
+		if ( frames <= 0 )
 		{
-			std::cout << n << ": " << buf[ ( buf.size() + n ) % buf.size() ] << std::endl;
+			return;
 		}
+
+		render_voices( begin, end );
+
+		profiler_.lap( AudioProfiler::Section::VOICE );
+
+		std::array< const float*, PARTS > inputs;
+
+		for ( int p = 0; p < PARTS; p++ )
+		{
+			inputs[ p ] = part_buffer( static_cast< Part >( p ) ) + begin;
+		}
+
+		float* stereo = & stereo_buffer_[ begin * 2 ];
+		float* send = & send_buffer_[ begin ];
+
+		mixer_.mix( inputs, page_row_.active_parts, stereo, send, frames );
+		mixer_.add( & system_buffer_[ begin ], stereo, send, frames );
+
+		// ͍EʁXɏ̂ŁAo̓obt@ɕď
+		float* out_l = block.out[ 0 ] + begin;
+		float* out_r = block.out[ 1 ] + begin;
+
+		dsp::deinterleave( out_l, out_r, stereo, frames );
+
+		delay_.process( send, out_l, out_r, frames );
+		limiter_.process( out_l, out_r, frames );
+
+		if ( block.stems )
+		{
+			render_stems( block, inputs, begin, frames );
+		}
+
+		profiler_.lap( AudioProfiler::Section::MIX );
+
+		if ( is_bgm_ducked_ )
+		{
+			dsp::scale( out_l, get_bgm_volume(), frames );
+			dsp::scale( out_r, get_bgm_volume(), frames );
+			dsp::mul_add( out_l, block.in + begin, get_mic_volume(), frames );
+			dsp::mul_add( out_r, block.in + begin, get_mic_volume(), frames );
+		}
+
+		profiler_.lap( AudioProfiler::Section::OUTPUT );
 	}
 
-	void onAudio( gam::AudioIOData& io )
+	/// 蓖Ăp[g̏o͂ block.stems  [ begin, begin + frames ) ɏo
+	void render_stems( const Block& block, const std::array< const float*, PARTS >& inputs, int begin, int frames )
 	{
-		key_input();
+		for ( int c = ChannelMap::MAIN_CHANNELS; c < channel_map_.get_channel_count(); c++ )
+		{
+			dsp::clear( block.stems[ c ] + begin, frames );
+		}
 
-		if ( is_recording() )
+		for ( int p = 0; p < PARTS; p++ )
 		{
-			for ( int n = 0; n < io.framesPerBuffer(); n++ )
+			const Part part = static_cast< Part >( p );
+			const int channel = channel_map_.get_channel( part );
+
+			// ĂȂp[g part_buffer_ ͏ĂȂ̂œǂ܂Ȃ
+			if ( channel >= 0 && is_part_active( part ) )
 			{
-				if ( recording_frame_index_ < current_recording_buffer().size() )
-				{
-					current_recording_buffer()[ recording_frame_index_ ] = io.in( 0, n );
-					recording_frame_index_++;
-				}
+				mixer_.add_stem( part, inputs[ p ], block.stems[ channel ] + begin, frames );
 			}
 		}
 
-		int n = 0;
+		delay_stems( block, begin, frames );
+	}
 
-		while ( io() )
+	/**
+	 * block.stems  [ begin, begin + frames ) ~b^[̐ǂ݂̕x点A~b^[̏ŃNbv
+	 *
+	 * Xe̓~b^[ʂȂ̂ŁAx点ăC̃~bNXƃTvPʂő
+	 * `lɊ蓖Ăp[g𑫂AȂ̃t@Cŉʂグ肵ď𒴂͐؂
+	 */
+	void delay_stems( const Block& block, int begin, int frames )
+	{
+		const int mask = STEM_DELAY_FRAMES - 1;
+		const int latency = limiter_.get_latency();
+		const float threshold = limiter_.get_threshold();
+
+		for ( int c = ChannelMap::MAIN_CHANNELS; c < channel_map_.get_channel_count(); c++ )
 		{
-			is_on_step_ = false;
-			// is_on_beat_ = false;
-			// is_on_bar_  = false;
+			float* line = & stem_delay_[ static_cast< size_t >( c - ChannelMap::MAIN_CHANNELS ) * STEM_DELAY_FRAMES ];
+			float* stem = block.stems[ c ] + begin;
 
-			if ( timer() )
+			for ( int n = 0; n < frames; n++ )
 			{
-				current_step_lh_ = get_controller().get_lh();
-				current_step_rh_ = get_controller().get_rh();
-
-				on_note();
+				const int write = ( stem_delay_write_ + n ) & mask;
 
-				last_step_lh_ = current_step_lh_;
-				last_step_rh_ = current_step_rh_;
+				line[ write ] = stem[ n ];
+				stem[ n ] = std::min( std::max( line[ ( write - latency ) & mask ], -threshold ), threshold );
 			}
-
-			update_bass();
-			update_lead();
-
-			mix( io, n );
-
-			n++;
 		}
+
+		stem_delay_write_ = ( stem_delay_write_ + frames ) & mask;
 	}
 
-	void update_bass()
+	void update_bass_target()
 	{
 		if ( page == Page::BASS )
 		{
 			// x[X̃{[E̎̋ɂĕς
-			if ( leap.hand_count() == 2 )
+			if ( snapshot().hand_count == 2 )
 			{
-				bass_volume.target_value() = math::clamp( ( leap.lh_pos().distanceTo( leap.rh_pos() )  - 100.f ) / 1000.f, 0.f, 1.f );
+				bass_volume.target_value() = math::clamp( ( snapshot().lh_pos.distanceTo( snapshot().rh_pos )  - 100.f ) / 1000.f, 0.f, 1.f );
 			}
+		}
+	}
+
+	/// 1 Tvx[X̃{[ǂ ( QƎp )
+	void update_bass()
+	{
+		update_bass_target();
 
+		if ( page == Page::BASS )
+		{
 			bass_volume.chase();
 		}
 	}
 
-	bool is_lh_lead_position() const { return leap.is_lh_valid() && leap.lh_pos().z < area_threashold_z; }
-	bool is_rh_lead_position() const { return leap.is_rh_valid() && leap.rh_pos().z < area_threashold_z; }
+	bool is_lh_lead_position() const { return snapshot().is_lh_valid && snapshot().lh_pos.z < area_threashold_z; }
+	bool is_rh_lead_position() const { return snapshot().is_rh_valid && snapshot().rh_pos.z < area_threashold_z; }
 
-	void update_lead()
+	/// [h̃[gƉʂ̖ڕWlƑx߂
+	void update_lead_target()
 	{
 		const bool is_position_valid_l = is_lh_lead_position();
 		const bool is_position_valid_r = is_rh_lead_position();
 		
-		const bool is_ll = range_to_rate( leap.x_pos_to_rate( leap.lh_pos().x ), 0.10f, 0.25f ) < 0.5f; // 肪GA̍ɂ
-		const bool is_rr = range_to_rate( leap.x_pos_to_rate( leap.rh_pos().x ), 0.75f, 0.90f ) > 0.5f; // E肪EGẢEɂ
+		const bool is_ll = range_to_rate( leap.x_pos_to_rate( snapshot().lh_pos.x ), 0.10f, 0.25f ) < 0.5f; // 肪GA̍ɂ
+		const bool is_rr = range_to_rate( leap.x_pos_to_rate( snapshot().rh_pos.x ), 0.75f, 0.90f ) > 0.5f; // E肪EGẢEɂ
 
-		const bool is_portamento_l = page < Page::CLIMAX || is_ll;
-		const bool is_portamento_r = page < Page::CLIMAX || is_rr;
+		is_portamento_l_ = page < Page::CLIMAX || is_ll;
+		is_portamento_r_ = page < Page::CLIMAX || is_rr;
 
 		const float chase_speed_scale = ( page == Page::LEAD_R ? 0.25f : page == Page::LEAD_L ? 0.5f : 1.f );
-		const float chase_speed_l = ( is_portamento_l ? 0.0001f : 10.f ) * chase_speed_scale;
-		const float chase_speed_r = ( is_portamento_r ? 0.0005f : 10.f ) * chase_speed_scale;
+		const float chase_speed_l = ( is_portamento_l_ ? portamento_speed_l_ : 10.f ) * chase_speed_scale;
+		const float chase_speed_r = ( is_portamento_r_ ? portamento_speed_r_ : 10.f ) * chase_speed_scale;
 
 		constexpr static std::array< float, 8 > tones_diatonic_low  = { Tone::C4, Tone::D4, Tone::E4, Tone::F4, Tone::G4, Tone::A4, Tone::B4, Tone::C5, };
 		constexpr static std::array< float, 8 > tones_diatonic_high = { Tone::C5, Tone::D5, Tone::E5, Tone::F5, Tone::G5, Tone::A5, Tone::B5, Tone::C6, };
@@ -611,25 +1258,39 @@ public:
 		const auto& tones_l = tones_pentatonic_low;
 		const auto& tones_r = page == Page::CLIMAX ? tones_pentatonic_high : tones_pentatonic_mid;
 		
-		const auto target_tone_l = is_lh_lead_position() ? tones_l[ leap.y_pos_to_index( leap.lh_pos().y, tones_l.size() ) ] : tones_l[ tones_l.size() - 1 ];
-		const auto target_tone_r = is_rh_lead_position() ? tones_r[ leap.y_pos_to_index( leap.rh_pos().y, tones_r.size() ) ] : tones_r[ tones_r.size() - 1 ];
+		const auto target_tone_l = is_lh_lead_position() ? tones_l[ leap.y_pos_to_index( snapshot().lh_pos.y, tones_l.size() ) ] : tones_l[ tones_l.size() - 1 ];
+		const auto target_tone_r = is_rh_lead_position() ? tones_r[ leap.y_pos_to_index( snapshot().rh_pos.y, tones_r.size() ) ] : tones_r[ tones_r.size() - 1 ];
 
 		// std::cout << chase_speed_l << ", " << chase_speed_r << std::endl;
 
-		if ( is_on_step() || is_portamento_l )
-		{
-			lead_l.rate( math::chase( static_cast< float >( lead_l.rate() ), target_tone_l / Tone::C3, chase_speed_l ) );
-		}
-		if ( is_on_step() || is_portamento_r )
-		{
-			lead_r.rate( math::chase( static_cast< float >( lead_r.rate() ), target_tone_r / Tone::C3, chase_speed_r ) );
-		}
+		lead_l_rate.target_value() = target_tone_l / Tone::C3;
+		lead_r_rate.target_value() = target_tone_r / Tone::C3;
+
+		lead_l_rate.speed() = chase_speed_l;
+		lead_r_rate.speed() = chase_speed_r;
 
 		lead_l_volume.target_value() = is_position_valid_l ? 1.f : 0.f;
 		lead_r_volume.target_value() = is_position_valid_r ? 1.f : 0.f;
 
-		lead_l_volume.speed() = 0.0001f * ( is_position_valid_l ? 1.f : 0.2f );
-		lead_r_volume.speed() = 0.0001f * ( is_position_valid_r ? 1.f : 0.2f );
+		lead_l_volume.speed() = is_position_valid_l ? volume_attack_speed_ : volume_release_speed_;
+		lead_r_volume.speed() = is_position_valid_r ? volume_attack_speed_ : volume_release_speed_;
+	}
+
+	/// 1 Tv[h̃[gƉʂǂ ( QƎp )
+	void update_lead()
+	{
+		update_lead_target();
+
+		if ( is_on_step() || is_portamento_l_ )
+		{
+			lead_l_rate.chase();
+			lead_l.rate( lead_l_rate.value() );
+		}
+		if ( is_on_step() || is_portamento_r_ )
+		{
+			lead_r_rate.chase();
+			lead_r.rate( lead_r_rate.value() );
+		}
 
 		lead_l_volume.chase();
 		lead_r_volume.chase();
@@ -640,75 +1301,69 @@ public:
 		return static_cast< int >( page );
 	}
 
-	void mix( gam::AudioIOData& io, int io_step )
+	void mix( const Block& block, int n )
 	{
-		//                                                { RPS,   FOX,   TAP,   PAD,   BASS,  KICK, SNARE,  DEMO,    R,      L,  FREE,   MAX, FIN }
-		const std::array< float, PAGES >     delay_gain = { 0.25f, 0.50f, 0.25f, 0.25f, 0.10f, 0.10f, 0.10f, 0.10f, 0.20f, 0.20f, 0.20f, 0.30f, 0.75f };
-		const std::array< float, PAGES >  delay_feedbak = { 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f };
+		float l = 0.f, r = 0.f, send = 0.f;
 
-		float s = 0.f;
-			
-		s +=   kick() * get_part_volume( Part::KICK   ) * kick_env();
-		s +=  snare() * get_part_volume( Part::SNARE  ) * snare_env();
-		s +=   bass() * get_part_volume( Part::BASS   ) * bass_volume.value() * bass_env();
-		s += lead_l() * get_part_volume( Part::LEAD_L ) * lead_l_volume.value();
-		s += lead_r() * get_part_volume( Part::LEAD_R ) * lead_r_volume.value();
-		s +=    tap() * get_part_volume( Part::TAP    ) * tap_env();
+		std::array< float, PARTS > x;
 
-		s += ( rock_() + paper_() + scissors_() + thumbs_up_() ) * get_part_volume( Part::RPS );
-		s += ( sound_1_() + sound_2_() + sound_3_() + fox_() ) * get_part_volume( Part::FOX );
+		x[ static_cast< int >( Part::KICK ) ]   = kick();
+		x[ static_cast< int >( Part::SNARE ) ]  = snare();
+		x[ static_cast< int >( Part::BASS ) ]   = bass() * bass_volume.value() * bass_env();
+		x[ static_cast< int >( Part::LEAD_L ) ] = lead_l() * lead_l_volume.value();
+		x[ static_cast< int >( Part::LEAD_R ) ] = lead_r() * lead_r_volume.value();
+		x[ static_cast< int >( Part::TAP ) ]    = tap();
 
-		const float pad = ( pad1() + pad2() + pad3() ) / 3.f;
-		s += pad      * get_part_volume( Part::PAD );
-		s += bright() * get_part_volume( Part::BRIGHT ) * bright_env();
+		x[ static_cast< int >( Part::RPS ) ] = rock_() + paper_() + scissors_() + thumbs_up_();
+		x[ static_cast< int >( Part::FOX ) ] = sound_1_() + sound_2_() + sound_3_() + fox_();
 
-		s += page_down() + page_up();
-		s /= static_cast< float >( Part::MAX );
+		x[ static_cast< int >( Part::PAD ) ]    = pad1() + pad2() + pad3();
+		x[ static_cast< int >( Part::BRIGHT ) ] = bright();
 
-		// bq_filter.freq( leap.y_pos_to_rate( leap.rh_pos().y ) * 1000.f );
-		// s = bq_filter( s );
-
-		s = compress( s );
-		
-		s += delay( s * delay_gain[ get_page_index() ] + delay() * delay_feedbak[ get_page_index() ] );
-		s = compress( s );
-
-		if ( is_recording() || is_speaking_mode() )
+		for ( int p = 0; p < PARTS; p++ )
 		{
-			s *= get_bgm_volume();
-			s += io.in( 0, io_step ) * get_mic_volume();
+			mixer_.mix( static_cast< Part >( p ), x[ p ], l, r, send );
 		}
 
-		io.out( 0 ) = s;
-		io.out( 1 ) = s;
-	}
-
-	float compress( float level )
-	{
-		float compressor_max_level = 1.f;
+		if ( block.stems )
+		{
+			for ( int c = ChannelMap::MAIN_CHANNELS; c < channel_map_.get_channel_count(); c++ )
+			{
+				block.stems[ c ][ n ] = 0.f;
+			}
 
-		compressor_max_level = math::chase( compressor_max_level, 1.f, 0.0001f );
-		compressor_max_level = std::max( std::abs( level ), compressor_max_level );
+			for ( int p = 0; p < PARTS; p++ )
+			{
+				const int channel = channel_map_.get_channel( static_cast< Part >( p ) );
 
-		level /= ( compressor_max_level + 0.01f );
+				if ( channel >= 0 )
+				{
+					mixer_.add_stem( static_cast< Part >( p ), x[ p ], block.stems[ channel ][ n ] );
+				}
+			}
 
-		/*
-		if ( max_level > 1.f )
-		{
-			std::cout << "max: " << max_level << std::endl;
+			delay_stems( block, n, 1 );
 		}
-		*/
 
-		/*
-		if ( std::abs( level ) >= 1.f )
+		const float system = ( page_down() + page_up() ) * Mixer::MASTER_GAIN;
+		l += system;
+		r += system;
+		send += system;
+
+		// bq_filter.freq( leap.y_pos_to_rate( leap.rh_pos().y ) * 1000.f );
+		// s = bq_filter( s );
+
+		delay_.process( send, l, r );
+		limiter_.process( l, r, std::max( std::abs( l ), std::abs( r ) ) );
+
+		if ( is_recording() || is_speaking_mode() )
 		{
-			std::cout << level << ", " << max_level << std::endl;
+			l = l * get_bgm_volume() + block.in[ n ] * get_mic_volume();
+			r = r * get_bgm_volume() + block.in[ n ] * get_mic_volume();
 		}
-		*/
-
-		compressor_max_level = std::min( compressor_max_level, 10.f );
 
-		return level;
+		block.out[ 0 ][ n ] = l;
+		block.out[ 1 ][ n ] = r;
 	}
 
 	/**
@@ -795,12 +1450,12 @@ public:
 				Tone::C6, Tone::D6, Tone::E6, Tone::G6, Tone::A6,
 				Tone::C7
 			};
-			const auto tapped_y = l_tapped ? leap.lh_pos().y : leap.rh_pos().y;
+			const auto tapped_y = l_tapped ? snapshot().lh_pos.y : snapshot().rh_pos.y;
 			const int tap_index = leap.y_pos_to_index( tapped_y, tap_note.size() - random_note_range ) + rand() % random_note_range;
 			
-			tap.rate( ( page == Page::TAP && ! leap.is_lh_valid() ) ? 1.f : ( tap_note[ tap_index ] / Tone::C4 ) );
-			tap.reset();
-			tap_env.reset();
+			auto& voice = tap.trigger();
+			voice.player.rate( ( page == Page::TAP && ! snapshot().is_lh_valid ) ? 1.f : ( tap_note[ tap_index ] / Tone::C4 ) );
+			voice.start();
 		}
 
 		update_sequencer();
@@ -832,9 +1487,14 @@ public:
 		if ( page == Page::FINISH )
 		{
 			finished = true;
-			kick.rate( 1.f );
-			kick.range( 0.f, 10.f );
-			kick.reset();
+
+			// V[PT[炵LbNAŌ܂Ŗ炷LbNɒu
+			kick.stop();
+
+			auto& voice = kick.trigger();
+			voice.player.rate( 1.f );
+			voice.player.range( 0.f, 10.f );
+			voice.start();
 		}
 
 		on_step( ( step_ % 4 ) == 0, step_ == 0 );
@@ -894,97 +1554,70 @@ public:
 		}
 	}
 
-	void update_sequencer()
+	/// ỸgbN track  velocity  delay_frames Tvɖ炷
+	void trigger_track( Song::Track track, float velocity, int delay_frames )
 	{
-		const bool kick_on[ 4 ][ 2 ][ 16 ] = {
-			{
-				{ 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0 },
-				{ 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 1, 1 },
-			},
-			{
-				{ 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0 },
-				{ 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1, 1, 1 },
-			},
-			{
-				{ 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 1, 0 },
-				{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
-			},
+		switch ( track )
+		{
+			case Song::Track::KICK:
 			{
-				{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-				{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+				auto& voice = kick.trigger();
+				voice.player.range( std::min( 0.9f, get_slider_value_l( Page::KICK ) ), 0.15f );
+				voice.player.rate( rate_to_tone_rate( get_slider_value_r( Page::KICK ), RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
+				voice.start( velocity, delay_frames );
+				break;
 			}
-		};
-
-		const bool snare_on[ 4 ][ 2 ][ 16 ] = {
-			{
-				{ 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0 },
-				{ 0, 1, 0, 0, 1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1 }
-			},
-			{
-				{ 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0 },
-				{ 0, 0, 0, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1 }
-			},
-			{
-				{ 0, 0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0 },
-				{ 0, 0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 1, 1, 1 },
-			},
+			case Song::Track::SNARE:
 			{
-				{ 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
-				{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+				auto& voice = snare.trigger();
+				voice.player.range( std::min( 0.9f, get_slider_value_l( Page::SNARE ) ), 0.15f );
+				voice.player.rate( rate_to_tone_rate( get_slider_value_r( Page::SNARE ), RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
+				voice.start( velocity, delay_frames );
+				break;
 			}
-		};
-
-		const float bright_phrase[ 3 ][ 2 ][ 16 ] = {
-			{
-				{ Tone::C5, Tone::__, Tone::G5, Tone::__,  Tone::C6, Tone::__, Tone::C5, Tone::G5,  Tone::__, Tone::C6, Tone::__, Tone::C6,  Tone::G5, Tone::__, Tone::C6, Tone::__, },
-				{ Tone::C5, Tone::__, Tone::G5, Tone::__,  Tone::C6, Tone::__, Tone::C5, Tone::G5,  Tone::__, Tone::C6, Tone::__, Tone::C6,  Tone::G5, Tone::__, Tone::C6, Tone::__, },
-			},
+			case Song::Track::TAP:
 			{
-				{ Tone::A5, Tone::__, Tone::G5, Tone::__,  Tone::E5, Tone::__, Tone::D5, Tone::C5,  Tone::__, Tone::D5, Tone::__, Tone::E5,  Tone::D5, Tone::__, Tone::C5, Tone::__, },
-				{ Tone::A5, Tone::__, Tone::G5, Tone::__,  Tone::E5, Tone::__, Tone::D5, Tone::C5,  Tone::__, Tone::D5, Tone::__, Tone::G5,  Tone::D5, Tone::__, Tone::C5, Tone::__, },
-			},
-			{
-				{ Tone::C5, },
-				{ Tone::__, },
-			},
-		};
+				auto& voice = tap.trigger();
+				voice.player.rate( 1.f );
+				voice.start( velocity, delay_frames );
+				break;
+			}
+			default:
+				break;
+		}
+	}
 
+	void update_sequencer()
+	{
 		const int is_fill_in = ( bar_ % 4 ) < 3 ? 0 : 1;
 
-		/// @todo y[WɂȂ悤ɂ
-		const std::array< int, PAGES > kick_pattern = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 2, 3 };
-		const std::array< int, PAGES > snare_pattern = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 2, 3 };
+		const auto& rhythm = page_row_.rhythm;
+		const int position = rhythm.get_position( bar_, step_, Song::STEPS );
 
-		if ( kick_on[ kick_pattern[ get_page_index() ] ][ is_fill_in ][ step_ ] )
-		{
-			kick.range( std::min( 0.9f, get_slider_value_l( Page::KICK ) ), 0.15f );
-			kick.rate( rate_to_tone_rate( get_slider_value_r( Page::KICK ), RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
-			kick.reset();
-			kick_env.reset();
-		}
+		// XEBO͗̃Xebv̔TvPʂŒx点
+		const int swing_frames = static_cast< int >( rhythm.get_swing( position ) * get_frames_per_step() );
 
-		if ( snare_on[ snare_pattern[ get_page_index() ] ][ is_fill_in ][ step_ ] )
+		for ( uint32_t triggers = rhythm.get_triggers( is_fill_in, position ); triggers; )
 		{
-			snare.range( std::min( 0.9f, get_slider_value_l( Page::SNARE ) ), 0.15f );
-			snare.rate( rate_to_tone_rate( get_slider_value_r( Page::SNARE ), RHYTHM_RATE_MIN, RHYTHM_RATE_MAX ) );
-			snare.reset();
-			snare_env.reset();
+			const int track = Sequencer::pop_track( triggers );
+
+			trigger_track( static_cast< Song::Track >( track ), rhythm.get_velocity( is_fill_in, position, track ), swing_frames );
 		}
 
-		const float bright_tone = bright_phrase[ page == Page::FINISH ? 2 : ( page >= Page::FREE ? 1 : 0 ) ][ is_fill_in ][ step_ ];
+		const float bright_tone = page_row_.bright[ is_fill_in ][ step_ ];
 
 		if ( bright_tone  != Tone::__ )
 		{
-			bright.rate( bright_tone / Tone::C3 );
-			bright.reset();
-			bright_env.reset();
+			auto& voice = bright.trigger();
+			voice.player.rate( bright_tone / Tone::C3 );
+			voice.start( 1.f, swing_frames );
 		}
 	}
 
+	/// I[fBIXbhĂ΂̂ŁAł͕Wo͂ɏȂ ( y[W͉ʂɕ\Ă )
 	void on_page_changed( Page page, bool incremented )
 	{
-		std::cout << "--------------------" << std::endl;
-		std::cout << "page : " << get_page_name( page ) << std::endl;
+		compile_page();
 
 		if ( page == Page::BASS )
 		{
@@ -1020,7 +1653,7 @@ public:
 
 	int get_frames_per_beat() const
 	{
-		return static_cast< int >( audioIO().framesPerSecond() * 60 / get_bpm() );
+		return static_cast< int >( get_frames_per_second() * 60 / get_bpm() );
 	}
 
 	int get_frames_per_step() const
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "spsc_queue.h"
+
+#include <cstdint>
+
+/**
+ * ̓XbhI[fBIXbh֑鑀
+ */
+struct InputCommand
+{
+	enum class Type : uint8_t
+	{
+		PAGE_DOWN = 0,
+		PAGE_UP,
+		MOVE_L_SLIDER,		///< value XC_[𓮂
+		MOVE_R_SLIDER,		///< value EXC_[𓮂
+		MOVE_MIC_VOLUME,	///< value }CN̏o̓{[ς
+		MOVE_BGM_VOLUME,	///< value ^̏o̓{[ς
+		RECORD_START,
+		RECORD_STOP,
+		SPEAK_START,
+		SPEAK_STOP,
+		MOVE_BPM,			///< value e|ς
+		SET_BPM,			///< e| value ɂ
+	};
+
+	Type type;
+	float value;
+};
+
+typedef common::spsc_queue< InputCommand, 256 > InputQueue;
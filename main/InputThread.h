@@ -0,0 +1,100 @@
+#pragma once
+
+#include "InputCommand.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+/**
+ * ̓foCXp̃Xbhœǂ݁AInputCommand L[ɐς
+ *
+ * I[fBIXbh̓ubN̐擪ŃL[oŁA̓foCXɂ͐GȂ
+ */
+class InputThread
+{
+public:
+	/// ̓foCX
+	class Backend
+	{
+	public:
+		virtual ~Backend() { }
+
+		/// ̓foCXǂ݁AInputThread::post() ő𑗂Belapsed ͑O poll() ̕b
+		virtual void poll( InputThread& input, double elapsed ) = 0;
+	};
+
+	static const int POLL_INTERVAL_MS = 10;
+
+private:
+	InputQueue& queue_;
+	std::unique_ptr< Backend > backend_;
+
+	std::thread thread_;
+	std::atomic< bool > is_running_;
+	std::atomic< unsigned int > dropped_count_;	/// L[tŎ̂Ă̐
+
+public:
+	InputThread( InputQueue& queue, std::unique_ptr< Backend > backend )
+		: queue_( queue )
+		, backend_( std::move( backend ) )
+		, is_running_( false )
+		, dropped_count_( 0 )
+	{
+
+	}
+
+	~InputThread()
+	{
+		stop();
+	}
+
+	void start()
+	{
+		if ( ! backend_ || is_running_ )
+		{
+			return;
+		}
+
+		is_running_ = true;
+
+		thread_ = std::thread( [this] () {
+			auto last_time = std::chrono::steady_clock::now();
+
+			while ( is_running_ )
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( POLL_INTERVAL_MS ) );
+
+				const auto time = std::chrono::steady_clock::now();
+				backend_->poll( *this, std::chrono::duration< double >( time - last_time ).count() );
+				last_time = time;
+			}
+		} );
+	}
+
+	void stop()
+	{
+		is_running_ = false;
+
+		if ( thread_.joinable() )
+		{
+			thread_.join();
+		}
+	}
+
+	/// L[ɐςށBL[t̏ꍇ͎̂Ă false Ԃ
+	bool post( InputCommand::Type type, float value = 0.f )
+	{
+		if ( ! queue_.push( InputCommand { type, value } ) )
+		{
+			dropped_count_++;
+			return false;
+		}
+
+		return true;
+	}
+
+	unsigned int get_dropped_count() const { return dropped_count_; }
+
+}; // class InputThread
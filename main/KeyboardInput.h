@@ -0,0 +1,184 @@
+#pragma once
+
+#include "InputThread.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+/**
+ * L[{[h̓
+ *
+ * Windows ł̓L[ĂԂ̏Ԃ GetAsyncKeyState() Œׂ
+ *    /          : y[W
+ *   1 / 7 , 3 / 9  : ẼXC_[ ( eL[ )
+ *   Z / X , C / V  : }CN / BGM ̃{[
+ *   - / +          : e| ( eL[ )
+ *   R              : ĂԘ^
+ *   SPACE          : ĂԂׂ郂[h
+ *
+ * ȊO̊ł͒[ raw [hɂĕW͂ǂ
+ * L[𗣂Ƃ͕Ȃ̂ŁAXC_[ƃ{[ 1 񉟂ɓAR  SPACE ͉xɐ؂ւ
+ */
+class KeyboardInput : public InputThread::Backend
+{
+public:
+	static constexpr float SLIDER_SPEED = 0.02f * 44100.f / 64.f;		///< 1 b̃XC_[̑x ( ] 1 ubN̑xɍ킹Ă )
+	static constexpr float VOLUME_SPEED = 0.001f * 44100.f / 64.f;		///< 1 b̃{[̑x
+	static constexpr float BPM_SPEED = 10.f;							///< 1 b̃e|̑x
+
+	static constexpr float SLIDER_STEP = 0.05f;		///< [ 1 񉟂̃XC_[̈ړ
+	static constexpr float VOLUME_STEP = 0.01f;		///< [ 1 񉟂̃{[̕ω
+	static constexpr float BPM_STEP = 1.f;			///< [ 1 񉟂̃e|̕ω
+
+private:
+	bool is_recording_ = false;
+	bool is_speaking_ = false;
+
+#ifdef _WIN32
+	static bool is_key_down( int key )
+	{
+		return ( GetAsyncKeyState( key ) & 0b1000000000000000 ) != 0;
+	}
+
+	void post_while_key_down( InputThread& input, int key, InputCommand::Type type, float value )
+	{
+		if ( is_key_down( key ) )
+		{
+			input.post( type, value );
+		}
+	}
+
+	void post_on_change( InputThread& input, bool& state, bool is_down, InputCommand::Type on, InputCommand::Type off )
+	{
+		if ( is_down != state )
+		{
+			state = is_down;
+			input.post( is_down ? on : off );
+		}
+	}
+
+public:
+	void poll( InputThread& input, double elapsed ) override
+	{
+		using Type = InputCommand::Type;
+
+		const float slider = static_cast< float >( SLIDER_SPEED * elapsed );
+		const float volume = static_cast< float >( VOLUME_SPEED * elapsed );
+		const float bpm = static_cast< float >( BPM_SPEED * elapsed );
+
+		// y[W̓y[Wς܂ LeapSoundController  1 񕪂󂯕tȂ
+		post_while_key_down( input, VK_LEFT, Type::PAGE_DOWN, 0.f );
+		post_while_key_down( input, VK_RIGHT, Type::PAGE_UP, 0.f );
+
+		post_while_key_down( input, VK_NUMPAD1, Type::MOVE_L_SLIDER, -slider );
+		post_while_key_down( input, VK_NUMPAD7, Type::MOVE_L_SLIDER, +slider );
+		post_while_key_down( input, VK_NUMPAD3, Type::MOVE_R_SLIDER, -slider );
+		post_while_key_down( input, VK_NUMPAD9, Type::MOVE_R_SLIDER, +slider );
+
+		post_while_key_down( input, 'Z', Type::MOVE_MIC_VOLUME, -volume );
+		post_while_key_down( input, 'X', Type::MOVE_MIC_VOLUME, +volume );
+		post_while_key_down( input, 'C', Type::MOVE_BGM_VOLUME, -volume );
+		post_while_key_down( input, 'V', Type::MOVE_BGM_VOLUME, +volume );
+
+		post_while_key_down( input, VK_SUBTRACT, Type::MOVE_BPM, -bpm );
+		post_while_key_down( input, VK_ADD, Type::MOVE_BPM, +bpm );
+
+		post_on_change( input, is_recording_, is_key_down( 'R' ), Type::RECORD_START, Type::RECORD_STOP );
+		post_on_change( input, is_speaking_, is_key_down( VK_SPACE ), Type::SPEAK_START, Type::SPEAK_STOP );
+	}
+#else
+	termios original_termios_;
+	bool is_raw_ = false;
+	int escape_ = 0;		/// GXP[vV[PXڂ܂œǂ񂾂
+
+	void toggle( InputThread& input, bool& state, InputCommand::Type on, InputCommand::Type off )
+	{
+		state = ! state;
+		input.post( state ? on : off );
+	}
+
+	void on_char( InputThread& input, char c )
+	{
+		using Type = InputCommand::Type;
+
+		if ( escape_ == 1 )
+		{
+			escape_ = c == '[' ? 2 : 0;
+			return;
+		}
+
+		if ( escape_ == 2 )
+		{
+			escape_ = 0;
+
+			if ( c == 'D' ) { input.post( Type::PAGE_DOWN ); }
+			if ( c == 'C' ) { input.post( Type::PAGE_UP ); }
+
+			return;
+		}
+
+		switch ( c )
+		{
+		case '\x1b': escape_ = 1; break;
+		case '1': input.post( Type::MOVE_L_SLIDER, -SLIDER_STEP ); break;
+		case '7': input.post( Type::MOVE_L_SLIDER, +SLIDER_STEP ); break;
+		case '3': input.post( Type::MOVE_R_SLIDER, -SLIDER_STEP ); break;
+		case '9': input.post( Type::MOVE_R_SLIDER, +SLIDER_STEP ); break;
+		case 'z': input.post( Type::MOVE_MIC_VOLUME, -VOLUME_STEP ); break;
+		case 'x': input.post( Type::MOVE_MIC_VOLUME, +VOLUME_STEP ); break;
+		case 'c': input.post( Type::MOVE_BGM_VOLUME, -VOLUME_STEP ); break;
+		case 'v': input.post( Type::MOVE_BGM_VOLUME, +VOLUME_STEP ); break;
+		case '-': input.post( Type::MOVE_BPM, -BPM_STEP ); break;
+		case '+': input.post( Type::MOVE_BPM, +BPM_STEP ); break;
+		case 'r': toggle( input, is_recording_, Type::RECORD_START, Type::RECORD_STOP ); break;
+		case ' ': toggle( input, is_speaking_, Type::SPEAK_START, Type::SPEAK_STOP ); break;
+		}
+	}
+
+public:
+	KeyboardInput()
+	{
+		if ( isatty( STDIN_FILENO ) && tcgetattr( STDIN_FILENO, & original_termios_ ) == 0 )
+		{
+			termios raw = original_termios_;
+			raw.c_lflag &= ~( ICANON | ECHO );
+			raw.c_cc[ VMIN ] = 0;
+			raw.c_cc[ VTIME ] = 0;
+
+			is_raw_ = tcsetattr( STDIN_FILENO, TCSANOW, & raw ) == 0;
+		}
+	}
+
+	~KeyboardInput()
+	{
+		if ( is_raw_ )
+		{
+			tcsetattr( STDIN_FILENO, TCSANOW, & original_termios_ );
+		}
+	}
+
+	void poll( InputThread& input, double ) override
+	{
+		if ( ! is_raw_ )
+		{
+			return;
+		}
+
+		char buffer[ 64 ];
+		ssize_t size;
+
+		while ( ( size = read( STDIN_FILENO, buffer, sizeof( buffer ) ) ) > 0 )
+		{
+			for ( ssize_t n = 0; n < size; n++ )
+			{
+				on_char( input, buffer[ n ] );
+			}
+		}
+	}
+#endif
+
+}; // class KeyboardInput
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * LeapSoundController  1 t[Ɏgf[^
+ *
+ * LeapFrameRecorder ̍\̂̂܂܌Œ蒷ŏoALeapFrameReplayer  memory map ēǂݍ
+ * CAEgύXꍇ VERSION グ邱
+ */
+struct LeapFrameRecord
+{
+	static const uint32_t MAGIC = 0x52464C48;	///< "HLFR"
+	static const uint32_t VERSION = 1;
+
+	static const int MAX_HANDS = 2;				///< L^̍ő吔
+
+	/// 1 t[ŔWFX`[
+	enum Gesture : uint32_t
+	{
+		KEY_TAP_L	= 1 << 0,		///< ̃L[^bv
+		KEY_TAP_R	= 1 << 1,		///< ẼL[^bv
+		SWIPE_STOP	= 1 << 2,		///< XCv̏I ( swipe_direction L )
+	};
+
+	struct Hand
+	{
+		enum Flag : uint8_t
+		{
+			LEFT			= 1 << 0,
+			RIGHT			= 1 << 1,
+			FINGERS_VALID	= 1 << 2,	///< SĂ̎wL
+		};
+
+		uint8_t flags;
+		uint8_t finger_bits;			///< LтĂw ( 1 << Leap::Finger::Type )
+		uint8_t reserved[ 2 ];
+
+		float confidence;
+		float pinch_strength;
+		float wrist_position[ 3 ];
+
+		bool is_left() const { return flags & LEFT; }
+		bool is_right() const { return flags & RIGHT; }
+		bool is_fingers_valid() const { return flags & FINGERS_VALID; }
+	};
+
+	/// t@C̐擪
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t record_size;
+		uint32_t reserved;
+	};
+
+	int64_t timestamp;				///< Leap::Frame::timestamp() ( }CNb )
+	int32_t hand_count;				///< Leap::Frame::hands().count() ( hands ɓ肫Ȃ܂ )
+	uint32_t gestures;				///< Gesture ̑gݍ킹
+
+	float swipe_direction[ 3 ];
+	uint32_t reserved;
+
+	Hand hands[ MAX_HANDS ];
+
+	int recorded_hand_count() const { return hand_count < MAX_HANDS ? hand_count : MAX_HANDS; }
+};
+
+static_assert( sizeof( LeapFrameRecord::Hand ) == 24, "LeapFrameRecord::Hand layout changed" );
+static_assert( sizeof( LeapFrameRecord ) == 80, "LeapFrameRecord layout changed" );
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "LeapFrameRecord.h"
+
+#include <cstdio>
+#include <vector>
+
+/**
+ * LeapFrameRecord t@Cɏo
+ *
+ * LeapMotion ̃XbhĂ΂B݂ stdio Ńobt@O
+ */
+class LeapFrameRecorder
+{
+private:
+	FILE* file_ = nullptr;
+	std::vector< char > buffer_;
+	size_t record_count_ = 0;
+
+public:
+	LeapFrameRecorder() { }
+	~LeapFrameRecorder() { close(); }
+
+	LeapFrameRecorder( const LeapFrameRecorder& ) = delete;
+	LeapFrameRecorder& operator = ( const LeapFrameRecorder& ) = delete;
+
+	bool open( const char* file_name )
+	{
+		close();
+
+		file_ = std::fopen( file_name, "wb" );
+
+		if ( ! file_ )
+		{
+			return false;
+		}
+
+		buffer_.resize( sizeof( LeapFrameRecord ) * 1024 );
+		std::setvbuf( file_, & buffer_[ 0 ], _IOFBF, buffer_.size() );
+
+		const LeapFrameRecord::FileHeader header = { LeapFrameRecord::MAGIC, LeapFrameRecord::VERSION, sizeof( LeapFrameRecord ), 0 };
+		std::fwrite( & header, sizeof( header ), 1, file_ );
+
+		record_count_ = 0;
+
+		return true;
+	}
+
+	void close()
+	{
+		if ( file_ )
+		{
+			std::fclose( file_ );
+			file_ = nullptr;
+		}
+	}
+
+	bool is_open() const { return file_ != nullptr; }
+
+	void write( const LeapFrameRecord& record )
+	{
+		if ( file_ )
+		{
+			std::fwrite( & record, sizeof( record ), 1, file_ );
+			record_count_++;
+		}
+	}
+
+	size_t get_record_count() const { return record_count_; }
+
+}; // class LeapFrameRecorder
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "LeapFrameRecord.h"
+#include "LeapSoundController.h"
+#include "OfflineRenderer.h"
+#include "mapped_file.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+/**
+ * LeapFrameRecorder ŋL^t@C memory map čĐ
+ *
+ * t[̓}bv璼 LeapSoundController::process_frame() ɓn̂ŁAĐɃmۂȂ
+ */
+class LeapFrameReplayer : public OfflineRenderer::FrameSource
+{
+private:
+	common::mapped_file file_;
+
+	const LeapFrameRecord* records_ = nullptr;
+	size_t record_count_ = 0;
+	size_t index_ = 0;
+
+public:
+	LeapFrameReplayer() { }
+	explicit LeapFrameReplayer( const char* file_name ) { open( file_name ); }
+
+	bool open( const char* file_name )
+	{
+		records_ = nullptr;
+		record_count_ = 0;
+		index_ = 0;
+
+		if ( ! file_.open( file_name ) )
+		{
+			return false;
+		}
+
+		LeapFrameRecord::FileHeader header;
+
+		if ( file_.size() < sizeof( header ) )
+		{
+			file_.close();
+			return false;
+		}
+
+		std::memcpy( & header, file_.data(), sizeof( header ) );
+
+		if ( header.magic != LeapFrameRecord::MAGIC || header.version != LeapFrameRecord::VERSION || header.record_size != sizeof( LeapFrameRecord ) )
+		{
+			file_.close();
+			return false;
+		}
+
+		records_ = reinterpret_cast< const LeapFrameRecord* >( static_cast< const char* >( file_.data() ) + sizeof( header ) );
+		record_count_ = ( file_.size() - sizeof( header ) ) / sizeof( LeapFrameRecord );
+
+		return true;
+	}
+
+	bool is_open() const { return records_ != nullptr; }
+
+	size_t size() const { return record_count_; }
+	const LeapFrameRecord& operator [] ( size_t index ) const { return records_[ index ]; }
+
+	/// ŏ̃t[Ō̃t[܂ł̎ ( }CNb )
+	int64_t get_duration() const
+	{
+		return record_count_ ? records_[ record_count_ - 1 ].timestamp - records_[ 0 ].timestamp : 0;
+	}
+
+	void rewind() { index_ = 0; }
+
+	/// 擪 time ( }CNb ) ܂ł̃t[ controller ɓ͂
+	bool feed( LeapSoundController& controller, int64_t time ) override
+	{
+		while ( index_ < record_count_ && records_[ index_ ].timestamp - records_[ 0 ].timestamp <= time )
+		{
+			controller.process_frame( records_[ index_ ] );
+			index_++;
+		}
+
+		return index_ < record_count_;
+	}
+
+	/**
+	 * L^ꂽԒʂɍĐ
+	 *
+	 * LeapMotion ̑ɐp̃XbhĂԁBis_playing  false ɂȂ邩Ō܂ōĐƖ߂
+	 */
+	void play( LeapSoundController& controller, const std::atomic< bool >& is_playing )
+	{
+		rewind();
+
+		const auto start_time = std::chrono::steady_clock::now();
+
+		while ( is_playing && feed( controller, std::chrono::duration_cast< std::chrono::microseconds >( std::chrono::steady_clock::now() - start_time ).count() ) )
+		{
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+	}
+
+}; // class LeapFrameReplayer
@@ -1,18 +1,22 @@
 #pragma once
 
 #include "math.h"
+#include "triple_buffer.h"
+#include "LeapFrameRecord.h"
+#include "LeapFrameRecorder.h"
+#include "Page.h"
 #include <iostream>
 #include <array>
 #include <algorithm>
+#include <atomic>
 #include <cstring>
-#include <chrono>
+#include <cstdint>
 #include <Leap.h>
 
 class LeapSoundController : public Leap::Listener
 {
 public:
-	/// @todo HandAudioCallback::Page::MAX ƎIɈv
-	static const int PAGES = 13;
+	static const int PAGES = ::PAGES;
 
 	class Hand
 	{
@@ -60,18 +64,17 @@ public:
 	private:
 		Shape shape_ = Shape::NONE;
 
-	protected:
-		void update_shape_by_leap_hand( const Leap::Hand hand )
+	public:
+		/// Leap::Hand ̎w̏Ԃ擾BȎw false Ԃ
+		static bool get_finger_bits( const Leap::Hand& hand, int& finger_bit )
 		{
-			shape_ = Shape::NONE;
-
-			int finger_bit = 0;
+			finger_bit = 0;
 
 			for ( const auto& f : hand.fingers() )
 			{
 				if ( ! f.isValid() )
 				{
-					return;
+					return false;
 				}
 
 				if ( f.isExtended() )
@@ -80,6 +83,19 @@ public:
 				}
 			}
 
+			return true;
+		}
+
+	protected:
+		void update_shape_by_finger_bits( bool is_fingers_valid, int finger_bit )
+		{
+			shape_ = Shape::NONE;
+
+			if ( ! is_fingers_valid )
+			{
+				return;
+			}
+
 			for ( int n = 0; n < static_cast< int >( Shape::NONE ); n++ )
 			{
 				if ( finger_bit == shape_bits_[ n ] )
@@ -96,41 +112,68 @@ public:
 			shape_ = Shape::NONE;
 		}
 
-		void update_by_leap_hand( const Leap::Hand hand )
+		void update_by_record( const LeapFrameRecord::Hand& hand )
 		{
-			update_shape_by_leap_hand( hand );
+			update_shape_by_finger_bits( hand.is_fingers_valid(), hand.finger_bits );
 		}
 
 		Shape get_shape() const { return shape_; }
 		const char* get_shape_name() const { return shape_names_[ static_cast< int >( shape_ ) ]; }
 	};
 
+	/**
+	 * I[fBIXbhɎ󂯓n 1 t[̎̏
+	 *
+	 * onFrame() ̍Ō publish AI[fBIXbh̓ubN 1 ǂݍ
+	 */
+	struct Snapshot
+	{
+		int64_t timestamp = 0;			/// Leap::Frame::timestamp() ( }CNb )
+		int hand_count = 0;
+
+		bool is_lh_valid = false;
+		bool is_rh_valid = false;
+
+		Leap::Vector lh_pos;			/// Ō̍̈ʒu
+		Leap::Vector rh_pos;			/// Ō̉Ëʒu
+
+		Hand lh;						/// 
+		Hand rh;						/// E
+	};
+
 private:
-	int page_ = 0;
-	bool page_incremented_ = false;
-	bool page_decremented_ = false;
+	// ȉ̓I[fBIXbhǂݏ
+	std::atomic< int > page_ = 0;
+	std::atomic< bool > page_incremented_ = false;
+	std::atomic< bool > page_decremented_ = false;
+
+	// ̎ ( t[̃^CX^v ) ܂ŃXCvWFX`[~
+	int64_t swipe_stop_until_ = 0;
 
-	// ̎Ԃ܂ŃXCvWFX`[~
-	std::chrono::system_clock::time_point swipe_stop_until_ = std::chrono::system_clock::now();
+	std::array< std::atomic< float >, PAGES > l_slider_;
+	std::array< std::atomic< float >, PAGES > r_slider_;
 
-	std::array< float, PAGES > l_slider_;
-	std::array< float, PAGES > r_slider_;
+	std::atomic< bool > l_tapped_ = false;
+	std::atomic< bool > r_tapped_ = false;
 
-	bool l_tapped_ = false;
-	bool r_tapped_ = false;
+	common::triple_buffer< Snapshot > snapshot_;	/// I[fBIXbh֎󂯓n̏
 
 	Hand lh_;							/// 
 	Hand rh_;							/// E
 
-	Leap::Hand leap_lh_;				/// ŐV LeapMotion ̍
-	Leap::Hand leap_rh_;				/// ŐV LeapMotion ̉E
+	bool is_lh_valid_ = false;			/// ŐṼt[ɍ肪邩
+	bool is_rh_valid_ = false;			/// ŐṼt[ɉE肪邩
+
+	LeapFrameRecorder* recorder_ = nullptr;	/// 󂯎t[L^
 
 	Leap::Vector lh_pos_;				/// Ō̍̈ʒu
 	Leap::Vector rh_pos_;				/// Ō̉Ëʒu
 
-	bool is_l_slider_moving_ = false;	/// ݍ肪܂łtO
-	bool is_r_slider_moving_ = false;	/// ݉E肪܂łtO
+	// y[WςɃI[fBIXbh~߂
+	std::atomic< bool > is_l_slider_moving_ = false;	/// ݍ肪܂łtO
+	std::atomic< bool > is_r_slider_moving_ = false;	/// ݉E肪܂łtO
 
+	// ȉ LeapMotion ̃Xbhǂݏ
 	float l_slider_start_value_;		/// XC_[̈ړJn_ł̒l
 	float r_slider_start_value_;		/// EXC_[̈ړJn_ł̒l
 
@@ -145,18 +188,17 @@ private:
 protected:
 	void start_l_slider_moving( float y )
 	{
-		is_l_slider_moving_ = true;
 		l_slider_start_value_ = l_slider_[ page_ ];
 		l_slider_start_hand_y_ = y;
+		is_l_slider_moving_ = true;
 
 		// std::cout << "L Slider : Start" << std::endl;
 	}
 
 	void stop_l_slider_moving()
 	{
-		if ( is_l_slider_moving_ )
+		if ( is_l_slider_moving_.exchange( false ) )
 		{
-			is_l_slider_moving_ = false;
 
 			// std::cout << "L Slider : Stop" << std::endl;
 		}
@@ -164,18 +206,17 @@ protected:
 
 	void start_r_slider_moving( float y )
 	{
-		is_r_slider_moving_ = true;
 		r_slider_start_value_ = r_slider_[ page_ ];
 		r_slider_start_hand_y_ = y;
+		is_r_slider_moving_ = true;
 
 		// std::cout << "R Slider : Start" << std::endl;
 	}
 
 	void stop_r_slider_moving()
 	{
-		if ( is_r_slider_moving_ )
+		if ( is_r_slider_moving_.exchange( false ) )
 		{
-			is_r_slider_moving_ = false;
 
 			// std::cout << "R Slider : Stop" << std::endl;
 		}
@@ -197,6 +238,32 @@ protected:
 		}
 	}
 
+	/// page_  step ςBchanged ͕ςƂI[fBIXbhɓ`tO
+	bool step_page( int step, std::atomic< bool >& changed )
+	{
+		if ( changed.exchange( true ) )
+		{
+			return false;
+		}
+
+		int page = page_;
+
+		do
+		{
+			if ( page + step < 0 || page + step >= PAGES )
+			{
+				changed = false;
+				return false;
+			}
+		}
+		while ( ! page_.compare_exchange_weak( page, page + step ) );
+
+		stop_l_slider_moving();
+		stop_r_slider_moving();
+
+		return true;
+	}
+
 public:
 	LeapSoundController()
 	{
@@ -211,8 +278,8 @@ public:
 	const Hand& get_rh() const { return rh_; }
 
 	/// @todo Hand IuWFNgԂ悤ɂ
-	bool is_lh_valid() const { return leap_lh_.isValid(); }
-	bool is_rh_valid() const { return leap_rh_.isValid(); }
+	bool is_lh_valid() const { return is_lh_valid_; }
+	bool is_rh_valid() const { return is_rh_valid_; }
 
 	const Leap::Vector& lh_pos() const { return lh_pos_; }
 	const Leap::Vector& rh_pos() const { return rh_pos_; }
@@ -296,49 +363,30 @@ public:
 	int page() const { return page_; }
 	void set_page( int page ) { page_ = page; }
 
+	/**
+	 * y[W 1 ߂
+	 *
+	 * I[fBIXbh LeapMotion ̃Xbh̗Ă΂̂ŁAtOɎĂ
+	 * page_  compare_exchange ŕςAɌĂ΂Ă 1 񂵂ς炸͈͊OɂȂȂ悤ɂ
+	 */
 	bool decrement_page()
 	{
-		if ( page_ <= 0 || page_decremented_ )
-		{
-			return false;
-		}
-
-		stop_l_slider_moving();
-		stop_r_slider_moving();
-
-		page_--;
-		page_decremented_ = true;
-
-		return true;
+		return step_page( -1, page_decremented_ );
 	}
 
+	/// y[W 1 i߂ ( decrement_page() Ɠ̃XbhĂł悢 )
 	bool increment_page()
 	{
-		if ( page_ >= PAGES - 1 || page_incremented_ )
-		{
-			return false;
-		}
-
-		stop_l_slider_moving();
-		stop_r_slider_moving();
-
-		page_++;
-		page_incremented_ = true;
-
-		return true;
+		return step_page( 1, page_incremented_ );
 	}
 
 	bool pop_page_incremented()
 	{
-		bool result = page_incremented_;
-		page_incremented_ = false;
-		return result;
+		return page_incremented_.exchange( false );
 	}
 	bool pop_page_decremented()
 	{
-		bool result = page_decremented_;
-		page_decremented_ = false;
-		return result;
+		return page_decremented_.exchange( false );
 	}
 
 	bool is_page_incremented() const { return page_incremented_; }
@@ -346,16 +394,12 @@ public:
 
 	bool pop_l_tapped()
 	{
-		bool result = l_tapped_;
-		l_tapped_ = false;
-		return result;
+		return l_tapped_.exchange( false );
 	}
 
 	bool pop_r_tapped()
 	{
-		bool result = r_tapped_;
-		r_tapped_ = false;
-		return result;
+		return r_tapped_.exchange( false );
 	}
 
 	int hand_count() const { return hand_count_;  }
@@ -366,6 +410,26 @@ public:
 	void set_y_min( float v ) { y_min_ = v; }
 	void set_y_max( float v ) { y_max_ = v; }
 
+	void set_recorder( LeapFrameRecorder* recorder ) { recorder_ = recorder; }
+
+	/**
+	 * Ō publish ꂽ̏Ԃ擾
+	 *
+	 * I[fBIXbĥ݌ĂԁB߂l͎ read_snapshot() ĂԂ܂ŕωȂ
+	 */
+	const Snapshot& read_snapshot()
+	{
+		snapshot_.update();
+		return snapshot_.front();
+	}
+
+	/// L^ς݂̎̏ԂI[fBIXbhɎ󂯓n ( ItC_Op )
+	void publish_snapshot( const Snapshot& snapshot )
+	{
+		snapshot_.back() = snapshot;
+		snapshot_.publish();
+	}
+
 public:
     void onInit( const Leap::Controller& ) override { std::cout << "Initialized" << std::endl; }
 	
@@ -388,99 +452,167 @@ public:
 	
 	void onFrame(const Leap::Controller& controller ) override
 	{
-		const Leap::Frame frame = controller.frame();
-		
-		hand_count_ = frame.hands().count();
+		const LeapFrameRecord record = make_record( controller.frame() );
 
-		// std::cout << "hands: " << frame.hands().count();
-		// std::cout << ", extended fingers: " << frame.fingers().extended().count();
+		if ( recorder_ )
+		{
+			recorder_->write( record );
+		}
+
+		process_frame( record );
+	}
+
+	/**
+	 * Leap::Frame Kvȃf[^o
+	 */
+	static LeapFrameRecord make_record( const Leap::Frame& frame )
+	{
+		LeapFrameRecord record = { };
+
+		record.timestamp = frame.timestamp();
+		record.hand_count = frame.hands().count();
 
 		for ( auto g : frame.gestures() )
 		{
-			if ( g.type() == Leap::Gesture::TYPE_CIRCLE )
-			{
-				on_circle_gesture( g );
-			}
-			else if ( g.type() == Leap::Gesture::TYPE_SWIPE )
+			if ( g.type() == Leap::Gesture::TYPE_SWIPE )
 			{
-				on_swipe_gesture( g );
+				const Leap::SwipeGesture swipe( g );
+
+				if ( swipe.state() == Leap::Gesture::STATE_STOP && ! ( record.gestures & LeapFrameRecord::SWIPE_STOP ) )
+				{
+					record.gestures |= LeapFrameRecord::SWIPE_STOP;
+					record.swipe_direction[ 0 ] = swipe.direction().x;
+					record.swipe_direction[ 1 ] = swipe.direction().y;
+					record.swipe_direction[ 2 ] = swipe.direction().z;
+				}
 			}
 			else if ( g.type() == Leap::Gesture::TYPE_KEY_TAP )
 			{
-				on_key_tap_gesture( g );
+				const Leap::KeyTapGesture tap( g );
+				const Leap::Finger f( tap.pointable() );
+
+				record.gestures |= f.hand().isLeft() ? LeapFrameRecord::KEY_TAP_L : LeapFrameRecord::KEY_TAP_R;
 			}
-			else if ( g.type() == Leap::Gesture::TYPE_SCREEN_TAP )
+		}
+
+		int n = 0;
+
+		for ( const auto& hand : frame.hands() )
+		{
+			if ( n >= LeapFrameRecord::MAX_HANDS )
 			{
-				on_screen_tap_gesture( g );
+				break;
 			}
-			
+
+			auto& h = record.hands[ n++ ];
+
+			int finger_bit = 0;
+
+			h.flags |= hand.isLeft() ? LeapFrameRecord::Hand::LEFT : 0;
+			h.flags |= hand.isRight() ? LeapFrameRecord::Hand::RIGHT : 0;
+			h.flags |= Hand::get_finger_bits( hand, finger_bit ) ? LeapFrameRecord::Hand::FINGERS_VALID : 0;
+			h.finger_bits = static_cast< uint8_t >( finger_bit );
+
+			h.confidence = hand.confidence();
+			h.pinch_strength = hand.pinchStrength();
+			h.wrist_position[ 0 ] = hand.wristPosition().x;
+			h.wrist_position[ 1 ] = hand.wristPosition().y;
+			h.wrist_position[ 2 ] = hand.wristPosition().z;
 		}
 
-		auto hands = frame.hands();
+		return record;
+	}
 
-		leap_lh_ = Leap::Hand::invalid();
-		leap_rh_ = Leap::Hand::invalid();
+	/**
+	 * 1 t[̏
+	 *
+	 * LeapMotion ̃t[ LeapFrameReplayer ōĐt[̗ʂ
+	 */
+	void process_frame( const LeapFrameRecord& frame )
+	{
+		hand_count_ = frame.hand_count;
+
+		// std::cout << "hands: " << frame.hand_count;
+
+		if ( frame.gestures & LeapFrameRecord::SWIPE_STOP )
+		{
+			on_swipe_gesture( frame.timestamp, Leap::Vector( frame.swipe_direction[ 0 ], frame.swipe_direction[ 1 ], frame.swipe_direction[ 2 ] ) );
+		}
+		if ( frame.gestures & LeapFrameRecord::KEY_TAP_L )
+		{
+			on_key_tap_gesture( true );
+		}
+		if ( frame.gestures & LeapFrameRecord::KEY_TAP_R )
+		{
+			on_key_tap_gesture( false );
+		}
+
+		is_lh_valid_ = false;
+		is_rh_valid_ = false;
 
 		lh_.reset();
 		rh_.reset();
 
-		for ( auto hl = hands.begin(); hl != hands.end(); ++hl )
+		for ( int n = 0; n < frame.recorded_hand_count(); n++ )
 		{
-			const auto hand = *hl;
+			const auto& hand = frame.hands[ n ];
+			const Leap::Vector wrist_position( hand.wrist_position[ 0 ], hand.wrist_position[ 1 ], hand.wrist_position[ 2 ] );
 
-			if ( hand.confidence() < 1.f )
+			if ( hand.confidence < 1.f )
 			{
-				if ( hand.isLeft() )
+				if ( hand.is_left() )
 				{
 					stop_l_slider_moving();
 				}
-				if ( hand.isRight() )
+				if ( hand.is_right() )
 				{
 					stop_r_slider_moving();
 				}
 
-				// std::cout << "c : " << hand.confidence() << std::endl;
+				// std::cout << "c : " << hand.confidence << std::endl;
 
 				continue;
 			}
 
-			if ( hand.isLeft() )
+			if ( hand.is_left() )
 			{
-				leap_lh_ = hand;
-				lh_pos_ = hand.wristPosition();
+				is_lh_valid_ = true;
+				lh_pos_ = wrist_position;
 
-				lh_.update_by_leap_hand( leap_lh_ );
+				lh_.update_by_record( hand );
 
-				if ( ! is_l_slider_moving_ && hand.pinchStrength() >= 1.f )
+				if ( ! is_l_slider_moving_ && hand.pinch_strength >= 1.f )
 				{
-					start_l_slider_moving( hand.wristPosition().y );
+					start_l_slider_moving( wrist_position.y );
 				}
-				else if ( is_l_slider_moving_ && hand.pinchStrength() <= 0.f )
+				else if ( is_l_slider_moving_ && hand.pinch_strength <= 0.f )
 				{
 					stop_l_slider_moving();
 				}
 
-				move_l_slider( hand.wristPosition().y );
+				move_l_slider( wrist_position.y );
 			}
-			else if ( hand.isRight() )
+			else if ( hand.is_right() )
 			{
-				leap_rh_ = hand;
-				rh_pos_ = hand.wristPosition();
+				is_rh_valid_ = true;
+				rh_pos_ = wrist_position;
 
-				rh_.update_by_leap_hand( leap_rh_ );
+				rh_.update_by_record( hand );
 
-				if ( ! is_r_slider_moving_ && hand.pinchStrength() >= 1.f )
+				if ( ! is_r_slider_moving_ && hand.pinch_strength >= 1.f )
 				{
-					start_r_slider_moving( hand.wristPosition().y );
+					start_r_slider_moving( wrist_position.y );
 				}
-				else if ( is_r_slider_moving_ && hand.pinchStrength() <= 0.f )
+				else if ( is_r_slider_moving_ && hand.pinch_strength <= 0.f )
 				{
 					stop_r_slider_moving();
 				}
 
-				move_r_slider( hand.wristPosition().y );
+				move_r_slider( wrist_position.y );
 			}
 		}
+
+		publish_snapshot( frame.timestamp );
 	}
 	
 	void onFocusGained(const Leap::Controller&) override { std::cout << "Focus Gained" << std::endl; }
@@ -548,40 +680,46 @@ public:
 
 protected:
 
-	void on_circle_gesture( const Leap::CircleGesture& circle )
+	void publish_snapshot( int64_t timestamp )
 	{
-		// std::cout << "circle : " << circle.toString() << " : " << circle.progress() << std::endl;
+		Snapshot& s = snapshot_.back();
+
+		s.timestamp = timestamp;
+		s.hand_count = hand_count_;
+		s.is_lh_valid = is_lh_valid_;
+		s.is_rh_valid = is_rh_valid_;
+		s.lh_pos = lh_pos_;
+		s.rh_pos = rh_pos_;
+		s.lh = lh_;
+		s.rh = rh_;
+
+		snapshot_.publish();
 	}
 
-	void on_swipe_gesture( const Leap::SwipeGesture& swipe )
+	void on_swipe_gesture( int64_t timestamp, const Leap::Vector& direction )
 	{
-		if ( swipe.state() != Leap::Gesture::STATE_STOP )
+		if ( std::abs( direction.x ) < std::abs( direction.y ) )
 		{
 			return;
 		}
 
-		if ( std::abs( swipe.direction().x ) < std::abs( swipe.direction().y ) )
+		if ( std::abs( direction.x ) < std::abs( direction.z ) )
 		{
 			return;
 		}
 
-		if ( std::abs( swipe.direction().x ) < std::abs( swipe.direction().z ) )
+		if ( timestamp < swipe_stop_until_ )
 		{
 			return;
 		}
 
-		auto now = std::chrono::system_clock::now();
-
-		if ( now < swipe_stop_until_ )
-		{
-			return;
-		}
+		const int64_t swipe_stop_duration = 500 * 1000;
 
-		if ( swipe.direction().x > 0.f )
+		if ( direction.x > 0.f )
 		{
 			if ( decrement_page() )
 			{
-				swipe_stop_until_ = now + std::chrono::milliseconds( 500 );
+				swipe_stop_until_ = timestamp + swipe_stop_duration;
 			}
 		}
 		else
@@ -590,22 +728,19 @@ protected:
 			{
 				if ( increment_page() )
 				{
-					swipe_stop_until_ = now + std::chrono::milliseconds( 500 );
+					swipe_stop_until_ = timestamp + swipe_stop_duration;
 				}
 			}
 		}
 
-		// std::cout << "swipe : " << swipe.hands().isEmpty() << std::endl;
 		// std::cout << "leap page : " << page_ << std::endl;
 	}
 
-	void on_key_tap_gesture( const Leap::KeyTapGesture& tap )
+	void on_key_tap_gesture( bool is_left )
 	{
-		Leap::Finger f( tap.pointable() );
+		// std::cout << "key tap : " << ( is_left ? "L" : "R" ) << std::endl;
 
-		// std::cout << "key tap : " << tap.toString() << " : " << ( f.hand().isLeft() ? "L" : "R" ) << f.type() << std::endl;
-
-		if ( f.hand().isLeft() )
+		if ( is_left )
 		{
 			l_tapped_ = true;
 		}
@@ -614,12 +749,5 @@ protected:
 			r_tapped_ = true;
 		}
 	}
-
-	void on_screen_tap_gesture( const Leap::ScreenTapGesture& tap )
-	{
-		Leap::Finger f( tap.pointable() );
-
-		// std::cout << "screen tap : " << tap.toString() << " : " << ( f.hand().isLeft() ? "L" : "R" ) << f.type() << std::endl;
-	}
 };
 
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "dsp.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+/**
+ * EœQCǂ݃~b^[
+ *
+ * ͂ lookahead ̕x点ďo͂ÅԂɍẼs[N peak hold  lookahead ̊ԕێ
+ * A^bNƃ[X̎萔ŒǂGx[vAthreshold 𒴂ȂQC߂
+ * Gx[v̓ubN܂Ŏ̂ŁAubN̒ςĂ͕ςȂ
+ *
+ * s[Ňo dsp::abs_max()  4 Tv܂Ƃ߂čsAGx[vTvɒǂ
+ * ͍ŏɊmۂĂ̂ŁAI[fBIXbhł͊mۂȂ
+ */
+class Limiter
+{
+public:
+	constexpr static float DEFAULT_THRESHOLD = 0.98f;		///< o͂̏ (  -0.2 dBFS )
+	constexpr static float DEFAULT_LOOKAHEAD_MS = 1.5f;
+	constexpr static float DEFAULT_ATTACK_MS = 0.3f;		///< ǂ݂̊Ԃɒǂ悤ɁAǂ݂ 1/5 xɂ
+	constexpr static float DEFAULT_RELEASE_MS = 100.f;
+
+	static const int MAX_LOOKAHEAD_FRAMES = 1024;			///< 2 ̗ݏ
+	static const int CHUNK_FRAMES = 64;						///< s[N܂Ƃ߂Čo钷
+
+private:
+	static const int DELAY_MASK = MAX_LOOKAHEAD_FRAMES - 1;
+
+	float threshold_ = DEFAULT_THRESHOLD;
+	float lookahead_ms_ = DEFAULT_LOOKAHEAD_MS;
+	float attack_ms_ = DEFAULT_ATTACK_MS;
+	float release_ms_ = DEFAULT_RELEASE_MS;
+
+	double frames_per_second_ = 44100.0;
+
+	// set_frames_per_second() ŋ߂l
+	int lookahead_ = 0;
+	float attack_coefficient_ = 0.f;
+	float release_coefficient_ = 0.f;
+
+	std::array< float, MAX_LOOKAHEAD_FRAMES > delay_l_ = { };
+	std::array< float, MAX_LOOKAHEAD_FRAMES > delay_r_ = { };
+	int write_ = 0;
+
+	float hold_ = 0.f;				/// ǂ݂̊ԕێĂs[N
+	int hold_frames_ = 0;			/// hold_ ƉTvێ邩
+	float envelope_ = 0.f;
+
+	float min_gain_ = 1.f;			/// take_min_gain() Ăł̍ŏ̃QC
+
+	void update_coefficients()
+	{
+		lookahead_ = std::min( static_cast< int >( lookahead_ms_ * 0.001 * frames_per_second_ ), MAX_LOOKAHEAD_FRAMES - 1 );
+		attack_coefficient_ = static_cast< float >( std::exp( -1.0 / ( std::max( attack_ms_, 0.001f ) * 0.001 * frames_per_second_ ) ) );
+		release_coefficient_ = static_cast< float >( std::exp( -1.0 / ( std::max( release_ms_, 0.001f ) * 0.001 * frames_per_second_ ) ) );
+	}
+
+public:
+	Limiter()
+	{
+		update_coefficients();
+	}
+
+	void set_frames_per_second( double frames_per_second )
+	{
+		frames_per_second_ = frames_per_second;
+		update_coefficients();
+	}
+
+	void set_threshold( float threshold ) { threshold_ = threshold; }
+	void set_lookahead( float ms ) { lookahead_ms_ = ms; update_coefficients(); }
+	void set_attack( float ms ) { attack_ms_ = ms; update_coefficients(); }
+	void set_release( float ms ) { release_ms_ = ms; update_coefficients(); }
+
+	float get_threshold() const { return threshold_; }
+
+	/// ͂o͂܂ł̒x ( Tv )
+	int get_latency() const { return lookahead_; }
+
+	/**
+	 * 1 Tv
+	 *
+	 * @param peak max( | l |, | r | )
+	 */
+	void process( float& l, float& r, float peak )
+	{
+		if ( peak >= hold_ )
+		{
+			hold_ = peak;
+			hold_frames_ = lookahead_;
+		}
+		else if ( hold_frames_ > 0 )
+		{
+			hold_frames_--;
+		}
+		else
+		{
+			hold_ = peak;
+		}
+
+		envelope_ = hold_ + ( envelope_ - hold_ ) * ( hold_ > envelope_ ? attack_coefficient_ : release_coefficient_ );
+
+		const float gain = envelope_ > threshold_ ? threshold_ / envelope_ : 1.f;
+
+		min_gain_ = std::min( min_gain_, gain );
+
+		delay_l_[ write_ ] = l;
+		delay_r_[ write_ ] = r;
+
+		const int read = ( write_ - lookahead_ ) & DELAY_MASK;
+
+		write_ = ( write_ + 1 ) & DELAY_MASK;
+
+		// A^bNŒǂȂ̓Nbv
+		l = std::min( std::max( delay_l_[ read ] * gain, -threshold_ ), threshold_ );
+		r = std::min( std::max( delay_r_[ read ] * gain, -threshold_ ), threshold_ );
+	}
+
+	/// frames Tv ( l  r ͓obt@ł悢 )
+	void process( float* l, float* r, int frames )
+	{
+		float peak[ CHUNK_FRAMES ];
+
+		for ( int begin = 0; begin < frames; begin += CHUNK_FRAMES )
+		{
+			const int n = std::min( frames - begin, static_cast< int >( CHUNK_FRAMES ) );
+
+			dsp::abs_max( peak, l + begin, r + begin, n );
+
+			for ( int i = 0; i < n; i++ )
+			{
+				process( l[ begin + i ], r[ begin + i ], peak[ i ] );
+			}
+		}
+	}
+
+	/// OĂł̍ŏ̃QCԂAv蒼
+	float take_min_gain()
+	{
+		const float gain = min_gain_;
+		min_gain_ = 1.f;
+
+		return gain;
+	}
+
+}; // class Limiter
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "dsp.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * ^eCN[vĐ邽߂̃[v_TAȂڂNXtF[h
+ *
+ * [v̏I̓eCN̏I[̋߂́A[v̎n܂̓A^bNʒű߂̏̃[NXI
+ * n܂̌̒AO̔g`I̒O̔g`ƍł悭Ă ( Kݑւł傫 ) ʒuIԂ̂ŁA
+ * ƎANXtF[hĂłȂ
+ * ւ dsp::dot()  4 Tv߁AGlM[͈ʒu炵Ȃ獷ōXV
+ *
+ * apply() ̓[v̏I̒OAn܂̒O̔g`֓p[ŃNXtF[h
+ * ̂̓[v̒Ȃ̂ŁAVbgŐ擪炷ꍇ̃A^bN͕ςȂ
+ *
+ * ͊mۂȂ̂ŁA[J[Xbh牽xĂł悢
+ */
+class LoopFinder
+{
+public:
+	constexpr static float CROSSFADE_TIME = 0.01f;		///< NXtF[h̒ ( b )
+	constexpr static float SEARCH_TIME = 0.02f;			///< [v_T͈ ( b )BłႢ 1 蒷
+	constexpr static float LOOP_START = 0.2f;			///< [v̎n܂̖ڈ ( eCN̒ɑ΂銄 )
+
+	static const int MIN_CROSSFADE_FRAMES = 16;			///< ZeCN̓eCNŜ̂܂܃[v
+
+	/// [v_ ( [ begin, end ) [v )
+	struct Loop
+	{
+		int begin;
+		int end;
+		int fade;			///< NXtF[h̃t[ ( 0 ȂNXtF[hȂ )
+		float score;		///< Ȃڂ̑O̔g`̑ ( -1 .. 1 )
+	};
+
+private:
+	int crossfade_frames_;
+	int search_frames_;
+
+	/// x[ n - 1 ]  x[ n ] ֏Ƀ[܂
+	static bool is_rising_zero_crossing( const float* x, int n )
+	{
+		return x[ n - 1 ] <= 0.f && x[ n ] > 0.f;
+	}
+
+public:
+	explicit LoopFinder( double frames_per_second )
+		: crossfade_frames_( static_cast< int >( CROSSFADE_TIME * frames_per_second ) )
+		, search_frames_( static_cast< int >( SEARCH_TIME * frames_per_second ) )
+	{
+
+	}
+
+	/// x  frames Tv烋[v_T ( x ͏Ȃ )
+	Loop find( const float* x, int frames ) const
+	{
+		Loop loop = { 0, frames, 0, 0.f };
+
+		const int fade = std::min( crossfade_frames_, frames / 8 );
+		const int radius = std::min( search_frames_, frames / 8 );
+
+		if ( fade < MIN_CROSSFADE_FRAMES )
+		{
+			return loop;
+		}
+
+		// I͏I[ radius ̒ōł̃[NX
+		int end = frames - 1;
+
+		for ( int n = frames - 1; n > frames - 1 - radius; n-- )
+		{
+			if ( is_rising_zero_crossing( x, n ) )
+			{
+				end = n;
+				break;
+			}
+		}
+
+		const int target = static_cast< int >( frames * LOOP_START );
+		const int first = std::max( target - radius, fade );
+		const int last = std::min( target + radius, end - fade * 2 );
+
+		if ( first > last )
+		{
+			return loop;
+		}
+
+		const float* tail = x + end - fade;
+		const double tail_energy = dsp::dot( tail, tail, fade );
+
+		double energy = dsp::dot( x + first - fade, x + first - fade, fade );
+
+		int best_any = first, best_crossing = -1;
+		double score_any = -2.0, score_crossing = -2.0;
+
+		for ( int begin = first; begin <= last; begin++ )
+		{
+			const double score = dsp::dot( tail, x + begin - fade, fade ) / std::sqrt( tail_energy * energy + 1e-20 );
+
+			if ( score > score_any )
+			{
+				score_any = score;
+				best_any = begin;
+			}
+
+			if ( score > score_crossing && is_rising_zero_crossing( x, begin ) )
+			{
+				score_crossing = score;
+				best_crossing = begin;
+			}
+
+			//  [ begin - fade, begin )  1 Tvւ炷
+			energy += static_cast< double >( x[ begin ] ) * x[ begin ] - static_cast< double >( x[ begin - fade ] ) * x[ begin - fade ];
+			energy = std::max( energy, 0.0 );
+		}
+
+		// [NX ( ⍂{΂̏ꍇ ) ւőI
+		const bool has_crossing = best_crossing >= 0;
+
+		loop.begin = has_crossing ? best_crossing : best_any;
+		loop.end = end;
+		loop.fade = fade;
+		loop.score = static_cast< float >( has_crossing ? score_crossing : score_any );
+
+		return loop;
+	}
+
+	/// [v̏I̒O fade TvAn܂̒O̔g`֓p[ŃNXtF[h
+	static void apply( float* x, const Loop& loop )
+	{
+		float* out = x + loop.end - loop.fade;
+		const float* in = x + loop.begin - loop.fade;
+
+		for ( int n = 0; n < loop.fade; n++ )
+		{
+			const float angle = static_cast< float >( n + 1 ) / loop.fade * 1.5707963f;
+
+			out[ n ] = out[ n ] * std::cos( angle ) + in[ n ] * std::sin( angle );
+		}
+	}
+
+}; // class LoopFinder
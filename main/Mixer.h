@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Page.h"
+#include "dsp.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+/**
+ * p[g̃oX~LT[
+ *
+ * oX͉ʁEʁEZh ( fBC֑ ) Ay[Wς set_bus() 
+ * ẼQCƃZh̃QC߂ĂBubN̏̓QC|đōς
+ *
+ * E̓C^[[uobt@ dsp::mul_add_stereo()  4 Tv܂Ƃ߂đA
+ * Zh̓m̃obt@ɑ
+ *
+ * Xe MASTER_GAIN ̑ STEM_GAIN |ʂŁAp[g̏o͂ʂ̃`lɏo
+ */
+class Mixer
+{
+public:
+	/// Sp[g𑫂Ă傫Ȃ肷Ȃ悤ɁASẴoXɊ|QC
+	constexpr static float MASTER_GAIN = 1.f / static_cast< float >( PARTS );
+
+	/// ̋Ȃōł傫y[W̉
+	constexpr static float MAX_STEM_VOLUME = 2.f;
+
+	///  MAX_STEM_VOLUME ̃p[g 0 dBFS ɂȂ悤ɁAXeɊ|QC (  1 ̃p[g͖ -6 dBFS )
+	constexpr static float STEM_GAIN = 1.f / MAX_STEM_VOLUME;
+
+	struct Bus
+	{
+		float gain_l = 0.f;
+		float gain_r = 0.f;
+		float send = 0.f;		///< Zh̃QC
+		float stem = 0.f;		///< Xe ( pO ) ̃QC
+	};
+
+private:
+	std::array< Bus, PARTS > buses_;
+
+public:
+	/**
+	 * oX̐ݒς
+	 *
+	 * ʂ̓oX^ ( ōEƂ volumeAБɐUƔΑ ) Ȃ̂ŁÃp[g̉ʂ͕ςȂ
+	 *
+	 * @param pan -1 :  .. 1 : E
+	 */
+	void set_bus( Part part, float volume, float pan, float send )
+	{
+		const int p = static_cast< int >( part );
+		const float gain = volume * MASTER_GAIN;
+
+		pan = std::min( std::max( pan, -1.f ), 1.f );
+
+		buses_[ p ].gain_l = gain * std::min( 1.f, 1.f - pan );
+		buses_[ p ].gain_r = gain * std::min( 1.f, 1.f + pan );
+		buses_[ p ].send = gain * send;
+		buses_[ p ].stem = volume * STEM_GAIN;
+	}
+
+	const Bus& get_bus( Part part ) const { return buses_[ static_cast< int >( part ) ]; }
+
+	/**
+	 * ep[g̏o inputs  frames Tv~bNX
+	 *
+	 * @param active_parts ~bNXp[g̃rbg}XN ( Song::PageRow::active_partsBȊÕp[g inputs ͓ǂ܂Ȃ )
+	 * @param stereo C^[[uXeȈo ( frames * 2 )
+	 * @param send Zh̏o
+	 */
+	void mix( const std::array< const float*, PARTS >& inputs, uint32_t active_parts, float* stereo, float* send, int frames ) const
+	{
+		dsp::clear( stereo, frames * 2 );
+		dsp::clear( send, frames );
+
+		for ( int p = 0; p < PARTS; p++ )
+		{
+			if ( ! ( ( active_parts >> p ) & 1u ) )
+			{
+				continue;
+			}
+
+			const Bus& bus = buses_[ p ];
+
+			dsp::mul_add_stereo( stereo, inputs[ p ], bus.gain_l, bus.gain_r, frames );
+
+			if ( bus.send != 0.f )
+			{
+				dsp::mul_add( send, inputs[ p ], bus.send, frames );
+			}
+		}
+	}
+
+	/// p[gł͂Ȃ ( y[WύXȂ ) 𒆉ɑ
+	void add( const float* input, float* stereo, float* send, int frames ) const
+	{
+		dsp::mul_add_stereo( stereo, input, MASTER_GAIN, MASTER_GAIN, frames );
+		dsp::mul_add( send, input, MASTER_GAIN, frames );
+	}
+
+	/// p[g̏o input  frames Tv stem ɑ
+	void add_stem( Part part, const float* input, float* stem, int frames ) const
+	{
+		dsp::mul_add( stem, input, buses_[ static_cast< int >( part ) ].stem, frames );
+	}
+
+	/// 1 Tv~bNXɑ ( QƎp )
+	void mix( Part part, float input, float& l, float& r, float& send ) const
+	{
+		const Bus& bus = buses_[ static_cast< int >( part ) ];
+
+		l += input * bus.gain_l;
+		r += input * bus.gain_r;
+		send += input * bus.send;
+	}
+
+	/// 1 Tv stem ɑ ( QƎp )
+	void add_stem( Part part, float input, float& stem ) const
+	{
+		stem += input * buses_[ static_cast< int >( part ) ].stem;
+	}
+
+}; // class Mixer
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "AudioProfileReporter.h"
+#include "HandAudioCallback.h"
+#include "LeapSoundController.h"
+#include "ScriptedInput.h"
+
+#include <Gamma/SoundFile.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * I[fBIfoCX LeapMotion g킸 HandAudioCallback _O
+ *
+ * L^ς݂̎̓ FrameSource ͂AHandAudioCallback::process() ̌ʂ
+ * CPU ̑ WAV t@Cɏo
+ *
+ * ChannelMap Ńp[g蓖Ăꍇ́AC̃~bNX̌̃`lɃp[g̃Xeׂ
+ * `l WAV t@C 1 ̃_Oŏo
+ */
+class OfflineRenderer
+{
+public:
+	/// L^ς݂̎̓
+	class FrameSource
+	{
+	public:
+		virtual ~FrameSource() { }
+
+		/// 擪 time ( }CNb ) ܂ł̃t[ controller ɓ͂BSē͂IĂ false Ԃ
+		virtual bool feed( LeapSoundController& controller, int64_t time ) = 0;
+	};
+
+	///  Snapshot ƃy[Wԍ̗
+	class SnapshotSequence : public FrameSource
+	{
+	public:
+		struct Frame
+		{
+			LeapSoundController::Snapshot snapshot;
+			int page;
+		};
+
+	private:
+		std::vector< Frame > frames_;
+		size_t index_ = 0;
+
+	public:
+		void add( const LeapSoundController::Snapshot& snapshot, int page )
+		{
+			frames_.push_back( Frame { snapshot, page } );
+		}
+
+		bool feed( LeapSoundController& controller, int64_t time ) override
+		{
+			while ( index_ < frames_.size() && frames_[ index_ ].snapshot.timestamp - frames_.front().snapshot.timestamp <= time )
+			{
+				controller.set_page( frames_[ index_ ].page );
+				controller.publish_snapshot( frames_[ index_ ].snapshot );
+				index_++;
+			}
+
+			return index_ < frames_.size();
+		}
+	};
+
+private:
+	LeapSoundController leap_;
+	HandAudioCallback audio_;
+
+public:
+	OfflineRenderer( double frames_per_second = HandAudioCallback::DEFAULT_FRAMES_PER_SECOND, int frames_per_buffer = HandAudioCallback::DEFAULT_FRAMES_PER_BUFFER, double bpm = HandAudioCallback::DEFAULT_BPM,
+		const ChannelMap& channel_map = ChannelMap() )
+		: audio_( leap_, frames_per_second, frames_per_buffer, bpm, channel_map )
+	{
+
+	}
+
+	HandAudioCallback& audio() { return audio_; }
+	LeapSoundController& leap() { return leap_; }
+
+	/**
+	 * source ͂Ƃ seconds b_OApath ɏo
+	 *
+	 * input w肵ꍇ́AL[{[h̑ɃXNvg̑ubN̐擪œ͂
+	 *
+	 * @return oɐǂ
+	 */
+	bool render( FrameSource& source, const std::string& path, double seconds, ScriptedInput* input = nullptr )
+	{
+		const double frames_per_second = audio_.get_frames_per_second();
+		const int frames = audio_.get_frames_per_buffer();
+		const int channels = audio_.channel_map().get_channel_count();
+
+		gam::SoundFile file( path );
+		file.format( gam::SoundFile::WAV ).encoding( gam::SoundFile::FLOAT ).channels( channels ).frameRate( frames_per_second );
+
+		if ( ! file.openWrite() )
+		{
+			std::cout << "could not open : " << path << std::endl;
+			return false;
+		}
+
+		std::vector< float > in( frames, 0.f );
+		std::vector< std::vector< float > > out( channels, std::vector< float >( frames, 0.f ) );
+		std::vector< float* > out_ptr( channels );
+		std::vector< float > interleaved( frames * channels, 0.f );
+
+		for ( int c = 0; c < channels; c++ )
+		{
+			out_ptr[ c ] = & out[ c ][ 0 ];
+		}
+
+		const HandAudioCallback::Block block = { & in[ 0 ], { out_ptr[ 0 ], out_ptr[ 1 ] }, frames, audio_.channel_map().empty() ? nullptr : & out_ptr[ 0 ] };
+
+		const int64_t total_frames = static_cast< int64_t >( seconds * frames_per_second );
+		const auto start_time = std::chrono::steady_clock::now();
+
+		for ( int64_t frame = 0; frame < total_frames; frame += frames )
+		{
+			const int64_t time = frame * 1000000 / static_cast< int64_t >( frames_per_second );
+
+			source.feed( leap_, time );
+
+			if ( input )
+			{
+				input->feed( audio_.input_queue(), time );
+			}
+
+			audio_.process( block );
+
+			// eCNւXebv CPU ̑ŕςȂ悤ɁA[J[҂ɂ̏ŉH
+			audio_.flush_takes();
+
+			for ( int n = 0; n < frames; n++ )
+			{
+				for ( int c = 0; c < channels; c++ )
+				{
+					interleaved[ n * channels + c ] = out[ c ][ n ];
+				}
+			}
+
+			file.write( & interleaved[ 0 ], frames );
+		}
+
+		file.close();
+
+		const double elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start_time ).count();
+
+		std::cout << "rendered " << seconds << " sec ( " << channels << " ch ) in " << elapsed << " sec ( x" << ( elapsed > 0.0 ? seconds / elapsed : 0.0 ) << " )" << std::endl;
+
+		AudioProfileReporter( audio_.profiler(), 0.0, std::string() ).print( std::cout );
+
+		return true;
+	}
+
+}; // class OfflineRenderer
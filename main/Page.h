@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string>
+
+/// Ȃ̐is ( y[W )
+enum class Page
+{
+	RPS,		// 񂯂
+	FOX,		// 1, 2, 3, tHbNX
+	TAP,		// L[^bṽf
+	PAD,		// pbh̃f
+	BASS,		// x[X̃f
+	KICK,		// LbN
+	SNARE,		// XlA
+	DEMO,		// demo
+	LEAD_R,		// [h R
+	LEAD_L,		// [h L
+	FREE,		// Rt ( i )
+	CLIMAX,		// NC}bNX
+	FINISH,		// I
+
+	MAX
+};
+
+/// ~bNX̒P ( p[g )
+enum class Part
+{
+	KICK = 0, SNARE, BASS, LEAD_L, LEAD_R, TAP, BRIGHT, PAD,
+	RPS, FOX,
+	MAX
+};
+
+static const int PAGES = static_cast< int >( Page::MAX );
+static const int PARTS = static_cast< int >( Part::MAX );
+
+/// y[W̖O ( ÓIȕȂ̂ŁAI[fBIXbhĂłmۂȂ )
+inline const char* get_page_name( Page page )
+{
+	static const char* const page_name_map[ PAGES ] = {
+		"RPS",
+		"FOX",
+		"TAP",
+		"PAD",
+		"BASS",
+		"KICK",
+		"SNARE",
+		"DEMO",
+		"LEAD_R",
+		"LEAD_L",
+		"FREE",
+		"CLIMAX",
+		"FINISH",
+	};
+
+	return page_name_map[ static_cast< int >( page ) ];
+}
+
+/// p[g̖O ( ÓIȕȂ̂ŁAI[fBIXbhĂłmۂȂ )
+inline const char* get_part_name( Part part )
+{
+	static const char* const part_name_map[ PARTS ] = {
+		"KICK", "SNARE", "BASS", "LEAD_L", "LEAD_R", "TAP", "BRIGHT", "PAD",
+		"RPS", "FOX",
+	};
+
+	return part_name_map[ static_cast< int >( part ) ];
+}
+
+/// Oy[W߂BȂ false Ԃ
+inline bool get_page_by_name( const std::string& name, Page& page )
+{
+	for ( int n = 0; n < PAGES; n++ )
+	{
+		if ( get_page_name( static_cast< Page >( n ) ) == name )
+		{
+			page = static_cast< Page >( n );
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Op[g߂BȂ false Ԃ
+inline bool get_part_by_name( const std::string& name, Part& part )
+{
+	for ( int n = 0; n < PARTS; n++ )
+	{
+		if ( get_part_name( static_cast< Part >( n ) ) == name )
+		{
+			part = static_cast< Part >( n );
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "dsp.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+/**
+ * YIN Ř^eCN̊{g߂
+ *
+ * eCN𔼕dȂ鑋ɕđɎ߁AL̑̒lԂ
+ * ֐͎ȑւ dsp::dot()  4 Tv߂đgݗĂB
+ * Ɨp̃obt@̓RXgN^ŊmۂĎg񂷂̂ŁAdetect() ł̓mۂȂ
+ *
+ * [J[XbhgBI[fBIXbh͌Ă΂Ȃ
+ */
+class PitchDetector
+{
+public:
+	constexpr static float MIN_FREQUENCY = 50.f;
+	constexpr static float MAX_FREQUENCY = 1000.f;
+	constexpr static float THRESHOLD = 0.15f;		///< Kŏ̒JƂ
+	constexpr static float SILENCE = 0.01f;			///<  RMS ȉȂ疳ƂĈ
+
+	static const int MAX_WINDOWS = 64;				///< 1 ̃eCN璲ׂ鑋̍ő吔
+
+private:
+	double frames_per_second_;
+	int min_lag_;
+	int max_lag_;
+	int window_;				/// 𑫂킹钷 ( łႢ 1  )
+
+	std::vector< float > difference_;				/// ̐K
+	std::array< float, MAX_WINDOWS > estimates_;	/// ̎g
+
+	/// x  window_ + max_lag_ Tv𒲂ׂĎgԂBȂ 0 Ԃ
+	float detect_window( const float* x )
+	{
+		const double energy = dsp::dot( x, x, window_ );
+
+		if ( energy < SILENCE * SILENCE * window_ )
+		{
+			return 0.f;
+		}
+
+		// d( tau ) =  ( x[ j ] - x[ j + tau ] )^2 = r( 0, 0 ) + r( tau, tau ) - 2 r( 0, tau )
+		double shifted_energy = energy;
+		double running_sum = 0.0;
+
+		difference_[ 0 ] = 1.f;
+
+		for ( int tau = 1; tau <= max_lag_; tau++ )
+		{
+			shifted_energy += static_cast< double >( x[ tau + window_ - 1 ] ) * x[ tau + window_ - 1 ] - static_cast< double >( x[ tau - 1 ] ) * x[ tau - 1 ];
+
+			const double d = std::max( energy + shifted_energy - 2.0 * dsp::dot( x, x + tau, window_ ), 0.0 );
+
+			running_sum += d;
+			difference_[ tau ] = running_sum > 0.0 ? static_cast< float >( d * tau / running_sum ) : 1.f;
+		}
+
+		for ( int tau = min_lag_; tau < max_lag_; tau++ )
+		{
+			if ( difference_[ tau ] >= THRESHOLD )
+			{
+				continue;
+			}
+
+			while ( tau + 1 < max_lag_ && difference_[ tau + 1 ] < difference_[ tau ] )
+			{
+				tau++;
+			}
+
+			// J̑O 3 _ŕԂ
+			const float a = difference_[ tau - 1 ];
+			const float b = difference_[ tau ];
+			const float c = difference_[ tau + 1 ];
+			const float denominator = a - 2.f * b + c;
+			const float shift = denominator > 0.f ? std::min( std::max( 0.5f * ( a - c ) / denominator, -0.5f ), 0.5f ) : 0.f;
+
+			return static_cast< float >( frames_per_second_ / ( tau + shift ) );
+		}
+
+		return 0.f;
+	}
+
+public:
+	explicit PitchDetector( double frames_per_second )
+		: frames_per_second_( frames_per_second )
+		, min_lag_( std::max( static_cast< int >( frames_per_second / MAX_FREQUENCY ), 2 ) )
+		, max_lag_( static_cast< int >( std::ceil( frames_per_second / MIN_FREQUENCY ) ) )
+		, window_( max_lag_ )
+		, difference_( max_lag_ + 1, 0.f )
+	{
+
+	}
+
+	/// 1 ̑𒲂ׂ̂ɕKvȃt[
+	int get_window_frames() const { return window_ + max_lag_; }
+
+	/// samples ̊{g ( Hz ) ԂB߂Ȃ 0 Ԃ
+	float detect( const float* samples, int frames )
+	{
+		const int span = frames - get_window_frames();
+
+		if ( span < 0 )
+		{
+			return 0.f;
+		}
+
+		const int hop = std::max( window_ / 2, span / ( MAX_WINDOWS - 1 ) + 1 );
+		int count = 0;
+
+		for ( int offset = 0; offset <= span && count < MAX_WINDOWS; offset += hop )
+		{
+			const float frequency = detect_window( samples + offset );
+
+			if ( frequency > 0.f )
+			{
+				estimates_[ count++ ] = frequency;
+			}
+		}
+
+		if ( count == 0 )
+		{
+			return 0.f;
+		}
+
+		std::nth_element( estimates_.begin(), estimates_.begin() + count / 2, estimates_.begin() + count );
+
+		return estimates_[ count / 2 ];
+	}
+
+}; // class PitchDetector
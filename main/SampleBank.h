@@ -0,0 +1,431 @@
+#pragma once
+
+#include "mapped_file.h"
+
+#include <Gamma/SoundFile.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ *  WAV t@C܂Ƃ߂ēǂݍ݁AfR[hς݂̃TvL
+ *
+ * ̓Xbhv[ŕɃfR[hAfR[hς݂̃TvLbVt@Cɏo
+ * 񂩂͌̃t@C̃TCYƍXVςĂȂ΃LbVt@C memory map 邾ōς
+ *
+ * pX⓯ẽt@C 1 ̃TvƂĎAvC[ buffer() ł̃QƂ
+ * vC[ɔjȂ
+ */
+class SampleBank
+{
+public:
+	/// fR[hς݂̃Tv ( gam::SamplePlayer::buffer() ɂ̂܂ܓn )
+	struct Sample
+	{
+		float* data = nullptr;
+		int frames = 0;
+		int channels = 0;
+		double frame_rate = 0.0;
+
+		explicit operator bool () const { return data != nullptr && frames > 0; }
+	};
+
+	/// LbVt@C̐擪
+	struct CacheHeader
+	{
+		static const uint32_t MAGIC = 0x4B425348;	///< "HSBK"
+		static const uint32_t VERSION = 2;		///< 2 : Tv`lɕׂĎ
+
+		uint32_t magic;
+		uint32_t version;
+		uint32_t entry_count;
+		uint32_t reserved;
+	};
+
+	/// LbVt@C 1 t@C̏ ( CacheHeader ̌ entry_count  )
+	struct CacheEntry
+	{
+		static const int MAX_NAME = 128;
+
+		char name[ MAX_NAME ];		///< ̃t@C̃pX
+		uint64_t source_size;		///< ̃t@C̃TCY
+		int64_t source_time;		///< ̃t@C̍XV
+		uint64_t offset;			///< LbVt@C̐擪Tv܂ł̃oCg
+		uint32_t frames;
+		uint32_t channels;
+		double frame_rate;
+	};
+
+	static const int DATA_ALIGNMENT = 16;
+
+private:
+	/// fR[h̃t@C
+	struct Source
+	{
+		std::string path;
+		uint64_t size = 0;
+		int64_t time = 0;
+
+		std::vector< float > samples;
+		int frames = 0;
+		int channels = 0;
+		double frame_rate = 0.0;
+
+		uint64_t hash = 0;
+		int same_as = -1;			/// e̐̃t@C (  -1 )
+	};
+
+	std::vector< std::string > paths_;
+	std::map< std::string, int > index_;
+	std::vector< Sample > samples_;
+
+	common::mapped_file cache_;
+	std::vector< std::vector< float > > decoded_;	/// LbVt@CgȂꍇ̃fR[hς݂̃Tv
+
+	static bool stat_file( const std::string& path, uint64_t& size, int64_t& time )
+	{
+		std::error_code error;
+
+		size = static_cast< uint64_t >( std::filesystem::file_size( path, error ) );
+
+		if ( error )
+		{
+			return false;
+		}
+
+		time = static_cast< int64_t >( std::filesystem::last_write_time( path, error ).time_since_epoch().count() );
+
+		return ! error;
+	}
+
+	static uint64_t hash( const Source& source )
+	{
+		// FNV-1a
+		uint64_t h = 14695981039346656037ull;
+
+		const auto* bytes = reinterpret_cast< const uint8_t* >( source.samples.data() );
+		const size_t size = source.samples.size() * sizeof( float );
+
+		for ( size_t n = 0; n < size; n++ )
+		{
+			h = ( h ^ bytes[ n ] ) * 1099511628211ull;
+		}
+
+		return h ^ static_cast< uint64_t >( source.frames ) ^ ( static_cast< uint64_t >( source.channels ) << 32 );
+	}
+
+	static bool is_same( const Source& a, const Source& b )
+	{
+		return a.hash == b.hash && a.frames == b.frames && a.channels == b.channels && a.frame_rate == b.frame_rate && a.samples == b.samples;
+	}
+
+	static void decode( Source& source )
+	{
+		gam::SoundFile file( source.path );
+
+		if ( ! file.openRead() )
+		{
+			std::cout << "could not load : " << source.path << std::endl;
+			return;
+		}
+
+		source.frames = file.frames();
+		source.channels = file.channels();
+		source.frame_rate = file.frameRate();
+		source.samples.resize( static_cast< size_t >( source.frames ) * source.channels );
+
+		if ( ! source.samples.empty() )
+		{
+			// gam::SamplePlayer ̓`lɕׂĎ̂ŁAload() ƓfC^[[uēǂ
+			file.readAllD( & source.samples[ 0 ] );
+		}
+
+		file.close();
+
+		source.hash = hash( source );
+	}
+
+	/// LbVt@C paths_ ƈvĂ memory map  samples_ ݒ肷
+	bool open_cache( const std::string& cache_path )
+	{
+		if ( ! cache_.open( cache_path.c_str() ) )
+		{
+			return false;
+		}
+
+		const auto* base = static_cast< const uint8_t* >( cache_.data() );
+		const auto* header = reinterpret_cast< const CacheHeader* >( base );
+		const size_t entries_end = sizeof( CacheHeader ) + sizeof( CacheEntry ) * paths_.size();
+
+		if ( cache_.size() < entries_end ||
+			header->magic != CacheHeader::MAGIC || header->version != CacheHeader::VERSION ||
+			header->entry_count != paths_.size() )
+		{
+			cache_.close();
+			return false;
+		}
+
+		const auto* entries = reinterpret_cast< const CacheEntry* >( base + sizeof( CacheHeader ) );
+
+		for ( size_t n = 0; n < paths_.size(); n++ )
+		{
+			const CacheEntry& entry = entries[ n ];
+
+			uint64_t size = 0;
+			int64_t time = 0;
+
+			// Oǂݍ߂Ȃt@ĆA܂΂̂܂܎g
+			if ( ! stat_file( paths_[ n ], size, time ) )
+			{
+				size = 0;
+				time = 0;
+			}
+
+			if ( paths_[ n ] != std::string( entry.name, strnlen( entry.name, CacheEntry::MAX_NAME ) ) ||
+				size != entry.source_size || time != entry.source_time ||
+				( entry.frames && entry.offset + static_cast< uint64_t >( entry.frames ) * entry.channels * sizeof( float ) > cache_.size() ) )
+			{
+				cache_.close();
+				return false;
+			}
+		}
+
+		for ( size_t n = 0; n < paths_.size(); n++ )
+		{
+			const CacheEntry& entry = entries[ n ];
+
+			// vC[͉ɏ܂Ȃ̂ŁAǂݍݐp̃̂܂ܓn
+			samples_[ n ].data = entry.frames ? reinterpret_cast< float* >( const_cast< uint8_t* >( base + entry.offset ) ) : nullptr;
+			samples_[ n ].frames = static_cast< int >( entry.frames );
+			samples_[ n ].channels = static_cast< int >( entry.channels );
+			samples_[ n ].frame_rate = entry.frame_rate;
+		}
+
+		return true;
+	}
+
+	static bool write_cache( const std::string& cache_path, const std::vector< Source >& sources )
+	{
+		std::ofstream out( cache_path, std::ios::binary | std::ios::trunc );
+
+		if ( ! out )
+		{
+			return false;
+		}
+
+		CacheHeader header = { CacheHeader::MAGIC, CacheHeader::VERSION, static_cast< uint32_t >( sources.size() ), 0 };
+		std::vector< CacheEntry > entries( sources.size() );
+
+		uint64_t offset = sizeof( CacheHeader ) + sizeof( CacheEntry ) * sources.size();
+
+		for ( size_t n = 0; n < sources.size(); n++ )
+		{
+			const Source& source = sources[ n ];
+			CacheEntry& entry = entries[ n ];
+
+			std::memset( & entry, 0, sizeof( entry ) );
+			std::strncpy( entry.name, source.path.c_str(), CacheEntry::MAX_NAME );
+
+			entry.source_size = source.size;
+			entry.source_time = source.time;
+			entry.frames = static_cast< uint32_t >( source.frames );
+			entry.channels = static_cast< uint32_t >( source.channels );
+			entry.frame_rate = source.frame_rate;
+
+			if ( source.same_as >= 0 )
+			{
+				entry.offset = entries[ source.same_as ].offset;
+				continue;
+			}
+
+			offset = ( offset + DATA_ALIGNMENT - 1 ) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+			entry.offset = offset;
+			offset += source.samples.size() * sizeof( float );
+		}
+
+		out.write( reinterpret_cast< const char* >( & header ), sizeof( header ) );
+		out.write( reinterpret_cast< const char* >( entries.data() ), sizeof( CacheEntry ) * entries.size() );
+
+		uint64_t position = sizeof( CacheHeader ) + sizeof( CacheEntry ) * sources.size();
+
+		for ( size_t n = 0; n < sources.size(); n++ )
+		{
+			if ( sources[ n ].same_as >= 0 || sources[ n ].samples.empty() )
+			{
+				continue;
+			}
+
+			static const char padding[ DATA_ALIGNMENT ] = { };
+
+			out.write( padding, static_cast< std::streamsize >( entries[ n ].offset - position ) );
+			out.write( reinterpret_cast< const char* >( sources[ n ].samples.data() ), sources[ n ].samples.size() * sizeof( float ) );
+
+			position = entries[ n ].offset + sources[ n ].samples.size() * sizeof( float );
+		}
+
+		return static_cast< bool >( out );
+	}
+
+public:
+	/// path ǂݍރt@CɉA̔ԍԂ ( pX͓ԍɂȂ )
+	int add( const std::string& path )
+	{
+		const auto i = index_.find( path );
+
+		if ( i != index_.end() )
+		{
+			return i->second;
+		}
+
+		const int id = static_cast< int >( paths_.size() );
+
+		paths_.push_back( path );
+		index_[ path ] = id;
+
+		return id;
+	}
+
+	/**
+	 * add() t@Cǂݍ
+	 *
+	 * cache_path ̃LbVt@Cg΂ memory map AgȂ threads ̃XbhŃfR[h
+	 * LbVt@C ( threads  0 Ȃ CPU ̐ )
+	 * LbVt@CoȂꍇfR[hTv͎g
+	 *
+	 * @return LbVt@Cgǂ
+	 */
+	bool load( const std::string& cache_path, int threads = 0 )
+	{
+		samples_.assign( paths_.size(), Sample() );
+		decoded_.clear();
+
+		if ( ! cache_path.empty() && open_cache( cache_path ) )
+		{
+			return true;
+		}
+
+		std::vector< Source > sources( paths_.size() );
+
+		for ( size_t n = 0; n < paths_.size(); n++ )
+		{
+			sources[ n ].path = paths_[ n ];
+
+			if ( ! stat_file( paths_[ n ], sources[ n ].size, sources[ n ].time ) )
+			{
+				sources[ n ].size = 0;
+				sources[ n ].time = 0;
+			}
+		}
+
+		if ( threads <= 0 )
+		{
+			threads = std::max( 1, static_cast< int >( std::thread::hardware_concurrency() ) );
+		}
+
+		threads = std::min( threads, static_cast< int >( sources.size() ) );
+
+		std::atomic< size_t > next( 0 );
+		std::vector< std::thread > workers;
+
+		for ( int n = 0; n < threads; n++ )
+		{
+			workers.emplace_back( [&] () {
+				for ( size_t i = next++; i < sources.size(); i = next++ )
+				{
+					decode( sources[ i ] );
+				}
+			} );
+		}
+
+		for ( auto& worker : workers )
+		{
+			worker.join();
+		}
+
+		for ( size_t n = 0; n < sources.size(); n++ )
+		{
+			for ( size_t m = 0; m < n; m++ )
+			{
+				if ( sources[ m ].same_as < 0 && is_same( sources[ n ], sources[ m ] ) )
+				{
+					sources[ n ].same_as = static_cast< int >( m );
+					sources[ n ].samples.clear();
+					break;
+				}
+			}
+		}
+
+		if ( ! cache_path.empty() && write_cache( cache_path, sources ) && open_cache( cache_path ) )
+		{
+			return true;
+		}
+
+		// LbVt@CȂꍇ́AfR[hTv̂܂܎g
+		decoded_.resize( sources.size() );
+
+		for ( size_t n = 0; n < sources.size(); n++ )
+		{
+			const Source& source = sources[ n ];
+			const int owner = source.same_as >= 0 ? source.same_as : static_cast< int >( n );
+
+			if ( source.same_as < 0 )
+			{
+				decoded_[ n ].swap( sources[ n ].samples );
+			}
+
+			samples_[ n ].data = decoded_[ owner ].empty() ? nullptr : & decoded_[ owner ][ 0 ];
+			samples_[ n ].frames = source.frames;
+			samples_[ n ].channels = source.channels;
+			samples_[ n ].frame_rate = source.frame_rate;
+		}
+
+		return false;
+	}
+
+	/// ԍ̃Tv ( ǂݍ߂Ȃꍇ͋ )
+	const Sample& get( int id ) const
+	{
+		static const Sample empty;
+
+		return id >= 0 && id < static_cast< int >( samples_.size() ) ? samples_[ id ] : empty;
+	}
+
+	/// pX̃Tv ( add() ĂȂǂݍ߂Ȃꍇ͋ )
+	const Sample& get( const std::string& path ) const
+	{
+		const auto i = index_.find( path );
+
+		return get( i != index_.end() ? i->second : -1 );
+	}
+
+	/**
+	 * player ̉ sample ɂ
+	 *
+	 * player  gam::SamplePlayer  buffer( T*, frames, frame_rate, channels )  ( VoicePool  )
+	 */
+	template< typename Player >
+	static bool assign( Player& player, const Sample& sample )
+	{
+		if ( ! sample )
+		{
+			return false;
+		}
+
+		player.buffer( sample.data, sample.frames, sample.frame_rate, sample.channels );
+
+		return true;
+	}
+
+}; // class SampleBank
+
+static_assert( sizeof( SampleBank::CacheHeader ) == 16, "SampleBank::CacheHeader layout changed" );
+static_assert( sizeof( SampleBank::CacheEntry ) == 168, "SampleBank::CacheEntry layout changed" );
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "InputThread.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * ߂ꂽɌ߂ꂽ𑗂
+ *
+ * XNvg 1 s 1 ̑ "<b> <> [ l ]" ̌`ŏB# ȍ~̓Rg
+ *
+ *   0.5  page_up
+ *   1.0  record_start
+ *   3.0  record_stop
+ *   4.0  l_slider 0.25
+ *
+ * InputThread  poll() ꍇ͊JňoߎԂŁAItC_Oł feed() ɓnő
+ */
+class ScriptedInput : public InputThread::Backend
+{
+public:
+	struct Event
+	{
+		int64_t time;		///< Jn̎ ( }CNb )
+		InputCommand command;
+	};
+
+private:
+	std::vector< Event > events_;
+	size_t index_ = 0;
+	double elapsed_ = 0.0;
+
+	static bool get_type( const std::string& name, InputCommand::Type& type )
+	{
+		using Type = InputCommand::Type;
+
+		static const std::pair< const char*, Type > names[] = {
+			{ "page_down", Type::PAGE_DOWN },
+			{ "page_up", Type::PAGE_UP },
+			{ "l_slider", Type::MOVE_L_SLIDER },
+			{ "r_slider", Type::MOVE_R_SLIDER },
+			{ "mic_volume", Type::MOVE_MIC_VOLUME },
+			{ "bgm_volume", Type::MOVE_BGM_VOLUME },
+			{ "record_start", Type::RECORD_START },
+			{ "record_stop", Type::RECORD_STOP },
+			{ "speak_start", Type::SPEAK_START },
+			{ "speak_stop", Type::SPEAK_STOP },
+			{ "bpm_move", Type::MOVE_BPM },
+			{ "bpm", Type::SET_BPM },
+		};
+
+		for ( const auto& n : names )
+		{
+			if ( name == n.first )
+			{
+				type = n.second;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+public:
+	void add( int64_t time, InputCommand::Type type, float value = 0.f )
+	{
+		Event event = { time, InputCommand { type, value } };
+
+		events_.insert( std::upper_bound( events_.begin(), events_.end(), event, [] ( const Event& a, const Event& b ) { return a.time < b.time; } ), event );
+	}
+
+	bool load( const char* file_path )
+	{
+		std::ifstream in( file_path );
+
+		if ( ! in )
+		{
+			return false;
+		}
+
+		std::string line;
+		int line_no = 0;
+
+		while ( std::getline( in, line ) )
+		{
+			line_no++;
+			line = line.substr( 0, line.find( '#' ) );
+
+			std::istringstream ss( line );
+
+			double seconds;
+			std::string name;
+			float value = 0.f;
+
+			if ( ! ( ss >> seconds >> name ) )
+			{
+				continue;
+			}
+
+			ss >> value;
+
+			InputCommand::Type type;
+
+			if ( ! get_type( name, type ) )
+			{
+				std::cout << file_path << "(" << line_no << ") : unknown command : " << name << std::endl;
+				continue;
+			}
+
+			add( static_cast< int64_t >( seconds * 1000000.0 ), type, value );
+		}
+
+		return true;
+	}
+
+	void rewind()
+	{
+		index_ = 0;
+		elapsed_ = 0.0;
+	}
+
+	///  time ( }CNb ) ܂ł̑ queue ɐςށBSđIĂ false Ԃ
+	bool feed( InputQueue& queue, int64_t time )
+	{
+		while ( index_ < events_.size() && events_[ index_ ].time <= time )
+		{
+			if ( ! queue.push( events_[ index_ ].command ) )
+			{
+				break;
+			}
+
+			index_++;
+		}
+
+		return index_ < events_.size();
+	}
+
+	void poll( InputThread& input, double elapsed ) override
+	{
+		elapsed_ += elapsed;
+
+		const int64_t time = static_cast< int64_t >( elapsed_ * 1000000.0 );
+
+		while ( index_ < events_.size() && events_[ index_ ].time <= time )
+		{
+			if ( ! input.post( events_[ index_ ].command.type, events_[ index_ ].command.value ) )
+			{
+				break;
+			}
+
+			index_++;
+		}
+	}
+
+}; // class ScriptedInput
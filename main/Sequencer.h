@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * 16 ̃Xebvɕ̃gbN炷YV[PT[
+ *
+ * Pattern ̓gbN 64 rbg̃Xebṽ}XNʏ̏߂ƃtBC̏߂̕
+ * y[Wς compile() ŃXebvɖ炷gbÑrbg̕\ ( Row ) ɕבւĂ̂ŁA
+ * Xebv͕̏\ 1 ėĂrbgɎoōς݁AgbNĂقƂǕςȂ
+ */
+class Sequencer
+{
+public:
+	static const int MAX_TRACKS = 16;
+	static const int MAX_STEPS = 64;	///< p^[̍ő̒ ( 16  4  )
+	static const int FILLS = 2;			///< 0 : ʏ̏, 1 : tBC̏
+
+	/// 1 gbÑp^[
+	struct Track
+	{
+		std::array< uint64_t, FILLS > steps = { };								///< n rbgڂ n Xebv
+		std::array< std::array< uint8_t, MAX_STEPS >, FILLS > velocity;		///< XebṽxVeB ( 255 ő )
+
+		Track()
+		{
+			for ( auto& v : velocity )
+			{
+				v.fill( 255 );
+			}
+		}
+	};
+
+	struct Pattern
+	{
+		int length = 16;		///< Xebv ( 1 .. MAX_STEPS )
+		float swing = 0.f;		///< ̃Xebvx点 ( Xebv̒ɑ΂銄 0 .. 0.5 )
+
+		std::array< Track, MAX_TRACKS > tracks;
+	};
+
+	/// Xebvɕבւp^[
+	struct Row
+	{
+		int length;
+		float swing;
+
+		std::array< std::array< uint32_t, MAX_STEPS >, FILLS > triggers;							///< Xebvɖ炷gbÑrbg
+		std::array< std::array< std::array< uint8_t, MAX_TRACKS >, MAX_STEPS >, FILLS > velocity;	///< XebṽgbÑxVeB
+
+		///  bar ̃Xebv step ł̃p^[̈ʒu (  16 Ȃ step ̂܂܁A64 Ȃ 4 ߂ 1  )
+		int get_position( int bar, int step, int steps_per_bar ) const
+		{
+			return ( bar * steps_per_bar + step ) % length;
+		}
+
+		uint32_t get_triggers( int fill, int position ) const { return triggers[ fill ][ position ]; }
+
+		float get_velocity( int fill, int position, int track ) const { return velocity[ fill ][ position ][ track ] / 255.f; }
+
+		/// position ̃Xebv̓x点 ( Xebv̒ɑ΂銄 )
+		float get_swing( int position ) const { return ( position & 1 ) ? swing : 0.f; }
+	};
+
+	static_assert( MAX_TRACKS <= 32, "Row::triggers must be able to hold all tracks" );
+
+	/// triggers ̍ł̃rbg̈ʒuԂÃrbg𗎂Ƃ
+	static int pop_track( uint32_t& triggers )
+	{
+#ifdef _MSC_VER
+		unsigned long track;
+		_BitScanForward( & track, triggers );
+#else
+		const int track = __builtin_ctz( triggers );
+#endif
+		triggers &= triggers - 1;
+
+		return static_cast< int >( track );
+	}
+
+	/// pattern Xebv̕\ɕבւ ( ̊mۂ͂Ȃ̂ŁAI[fBIXbhĂł悢 )
+	static void compile( const Pattern& pattern, Row& row )
+	{
+		row.length = pattern.length < 1 ? 1 : ( pattern.length > MAX_STEPS ? MAX_STEPS : pattern.length );
+		row.swing = pattern.swing;
+
+		for ( int fill = 0; fill < FILLS; fill++ )
+		{
+			for ( int step = 0; step < MAX_STEPS; step++ )
+			{
+				uint32_t bits = 0;
+
+				for ( int track = 0; track < MAX_TRACKS; track++ )
+				{
+					bits |= static_cast< uint32_t >( ( pattern.tracks[ track ].steps[ fill ] >> step ) & 1u ) << track;
+					row.velocity[ fill ][ step ][ track ] = pattern.tracks[ track ].velocity[ fill ][ step ];
+				}
+
+				row.triggers[ fill ][ step ] = bits;
+			}
+		}
+	}
+
+}; // class Sequencer
@@ -0,0 +1,479 @@
+#pragma once
+
+#include "Page.h"
+#include "Sequencer.h"
+#include "StereoDelay.h"
+#include "Tone.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Ȃ̒` ( y[W̉ʁEfBCEYp^[Et[Y )
+ *
+ * l̓y[W̔zƂĕׂĎ ( struct of arrays )Ay[Wς compile() 
+ * ̃y[W̒l PageRow ɂ܂Ƃ߂BI[fBIXbh PageRow ̍sł悢
+ *
+ * load() œǂݍރeLXgt@C̏ ( # ȍ~̓RgAȂl͊̋Ȃ̂܂ )
+ *
+ *	page    <y[W> <fBC̗> <fBC̃tB[hobN> <Ỹp^[> <uCg̃t[Y>
+ *	volume  <p[g> <y[W̉ ( RPS .. FINISH ̏ ) ...>
+ *	pan     <p[g> < ( -1 :  .. 1 : E )>
+ *	send    <p[g> <fBC֑ ( 0 .. 1 )>
+ *	tap     <y[W> <^bv̔ԍ ( 0 .. 3 )> < ( 2 ܂ )> < ( 0 ȂgȂ )> < ( -1 :  .. 1 : E )>
+ *	pattern <p^[> <Xebv ( 1 .. 64 )> [ <XEBO ( 0 .. 0.5 )> ]
+ *	track   <p^[> <gbN> <0 : ʏ | 1 : tBC> <Xebv 0 / 1 ( | ͓ǂݔ΂ )> [ <炷Xebv̉ ( 0 .. 1 )> ... ]
+ *	bright  <t[Y> <0 : ʏ | 1 : tBC> <16 Xebv̉ ( - ͋x )>
+ */
+class Song
+{
+public:
+	static const int STEPS = 16;		///< 1 ߂̃Xebv
+	static const int FILLS = Sequencer::FILLS;
+
+	/// ỸgbN ( Sequencer ̃gbN̔ԍ )
+	enum class Track
+	{
+		KICK = 0, SNARE, TAP,
+		MAX
+	};
+
+	static const int TRACKS = static_cast< int >( Track::MAX );
+
+	static_assert( TRACKS <= Sequencer::MAX_TRACKS, "too many tracks" );
+
+	/// Xebv̉ ( Tone::__ Ȃ炳Ȃ )
+	typedef std::array< std::array< float, STEPS >, FILLS > Phrase;
+
+	/// 1 y[W̒l
+	struct PageRow
+	{
+		std::array< float, PARTS > part_volume;
+		std::array< float, PARTS > part_pan;
+		std::array< float, PARTS > part_send;
+		uint32_t active_parts;			///< ʂ 0 łȂp[g̃rbg}XN
+
+		float delay_gain;
+		float delay_feedback;
+		std::array< StereoDelay::Tap, StereoDelay::MAX_TAPS > delay_taps;
+
+		Sequencer::Row rhythm;
+		Phrase bright;
+	};
+
+private:
+	std::array< std::array< float, PAGES >, PARTS > part_volume_;	/// [ p[g ][ y[W ]
+	std::array< float, PARTS > part_pan_;		/// p[g̒ ( y[WɂȂ )
+	std::array< float, PARTS > part_send_;		/// p[g̃fBC֑ ( y[WɂȂ )
+	std::array< float, PAGES > delay_gain_;
+	std::array< float, PAGES > delay_feedback_;
+	std::array< std::array< StereoDelay::Tap, StereoDelay::MAX_TAPS >, PAGES > delay_taps_;	/// [ y[W ][ ^bv ]
+	std::array< int, PAGES > rhythm_pattern_;
+	std::array< int, PAGES > bright_phrase_;
+
+	std::vector< Sequencer::Pattern > rhythm_patterns_;
+	std::vector< Phrase > bright_phrases_;
+
+	/// "1000100010001010" ̂悤ȕ񂩂p^[̃rbg ( '|' ͏߂̋؂Ƃēǂݔ΂ )
+	static bool parse_steps( const std::string& steps, uint64_t& bits, int& length )
+	{
+		bits = 0;
+		length = 0;
+
+		for ( char c : steps )
+		{
+			if ( c == '|' )
+			{
+				continue;
+			}
+
+			if ( length >= Sequencer::MAX_STEPS || ( c != '0' && c != '1' ) )
+			{
+				return false;
+			}
+
+			if ( c == '1' )
+			{
+				bits |= uint64_t( 1 ) << length;
+			}
+
+			length++;
+		}
+
+		return length > 0;
+	}
+
+	static Sequencer::Pattern make_pattern( const char* kick_normal, const char* kick_fill_in, const char* snare_normal, const char* snare_fill_in )
+	{
+		Sequencer::Pattern pattern;
+		int length;
+
+		parse_steps( kick_normal, pattern.tracks[ static_cast< int >( Track::KICK ) ].steps[ 0 ], length );
+		parse_steps( kick_fill_in, pattern.tracks[ static_cast< int >( Track::KICK ) ].steps[ 1 ], length );
+		parse_steps( snare_normal, pattern.tracks[ static_cast< int >( Track::SNARE ) ].steps[ 0 ], length );
+		parse_steps( snare_fill_in, pattern.tracks[ static_cast< int >( Track::SNARE ) ].steps[ 1 ], length );
+
+		return pattern;
+	}
+
+	static bool get_track_by_name( const std::string& name, Track& track )
+	{
+		static const std::array< std::string, TRACKS > track_name_map = { "kick", "snare", "tap" };
+
+		for ( int n = 0; n < TRACKS; n++ )
+		{
+			if ( track_name_map[ n ] == name )
+			{
+				track = static_cast< Track >( n );
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/// p^[̔ԍ̗ n ԖڂpӂA̗vfԂ
+	template< typename Type >
+	static Type& at( std::vector< Type >& list, int n )
+	{
+		if ( n >= static_cast< int >( list.size() ) )
+		{
+			list.resize( n + 1, Type() );
+		}
+
+		return list[ n ];
+	}
+
+	bool read_line( const std::string& line, std::string& error )
+	{
+		std::istringstream ss( line );
+		std::string command;
+
+		if ( ! ( ss >> command ) )
+		{
+			return true;
+		}
+
+		if ( command == "page" )
+		{
+			std::string name;
+			Page page;
+			float gain, feedback;
+			int rhythm, bright;
+
+			if ( ! ( ss >> name >> gain >> feedback >> rhythm >> bright ) || ! get_page_by_name( name, page ) )
+			{
+				error = "invalid page";
+				return false;
+			}
+
+			const int p = static_cast< int >( page );
+
+			delay_gain_[ p ] = gain;
+			delay_feedback_[ p ] = feedback;
+			rhythm_pattern_[ p ] = rhythm;
+			bright_phrase_[ p ] = bright;
+		}
+		else if ( command == "volume" )
+		{
+			std::string name;
+			Part part;
+
+			if ( ! ( ss >> name ) || ! get_part_by_name( name, part ) )
+			{
+				error = "invalid part";
+				return false;
+			}
+
+			for ( int p = 0; p < PAGES; p++ )
+			{
+				if ( ! ( ss >> part_volume_[ static_cast< int >( part ) ][ p ] ) )
+				{
+					error = "volume needs " + std::to_string( PAGES ) + " values";
+					return false;
+				}
+			}
+		}
+		else if ( command == "pan" || command == "send" )
+		{
+			std::string name;
+			Part part;
+			float value;
+
+			if ( ! ( ss >> name >> value ) || ! get_part_by_name( name, part ) )
+			{
+				error = "invalid " + command;
+				return false;
+			}
+
+			( command == "pan" ? part_pan_ : part_send_ )[ static_cast< int >( part ) ] = value;
+		}
+		else if ( command == "tap" )
+		{
+			std::string name;
+			Page page;
+			int index;
+			StereoDelay::Tap tap;
+
+			if ( ! ( ss >> name >> index >> tap.beats >> tap.gain >> tap.pan ) || ! get_page_by_name( name, page ) ||
+				index < 0 || index >= StereoDelay::MAX_TAPS || tap.beats < 0.f || tap.gain < 0.f || tap.pan < -1.f || tap.pan > 1.f )
+			{
+				error = "invalid tap";
+				return false;
+			}
+
+			delay_taps_[ static_cast< int >( page ) ][ index ] = tap;
+		}
+		else if ( command == "pattern" )
+		{
+			int index, length;
+			float swing = 0.f;
+
+			if ( ! ( ss >> index >> length ) || index < 0 || length < 1 || length > Sequencer::MAX_STEPS )
+			{
+				error = "invalid pattern";
+				return false;
+			}
+
+			if ( ( ss >> swing ) && ( swing < 0.f || swing > 0.5f ) )
+			{
+				error = "swing must be 0 .. 0.5";
+				return false;
+			}
+
+			auto& pattern = at( rhythm_patterns_, index );
+
+			pattern.length = length;
+			pattern.swing = swing;
+		}
+		else if ( command == "track" )
+		{
+			int index, fill, length;
+			std::string name, steps;
+			Track track;
+			uint64_t bits;
+
+			if ( ! ( ss >> index >> name >> fill >> steps ) || index < 0 || fill < 0 || fill >= FILLS || ! get_track_by_name( name, track ) || ! parse_steps( steps, bits, length ) )
+			{
+				error = "invalid track";
+				return false;
+			}
+
+			auto& t = at( rhythm_patterns_, index ).tracks[ static_cast< int >( track ) ];
+
+			t.steps[ fill ] = bits;
+			t.velocity[ fill ].fill( 255 );
+
+			// ʂ͖炷Xebv̕ɕׂ ( ȗXebv͍ő )
+			float velocity;
+
+			for ( int step = 0; step < length && ( ss >> velocity ); step++ )
+			{
+				while ( step < length && ! ( ( bits >> step ) & 1u ) )
+				{
+					step++;
+				}
+
+				if ( step < length )
+				{
+					t.velocity[ fill ][ step ] = static_cast< uint8_t >( std::lround( std::min( std::max( velocity, 0.f ), 1.f ) * 255.f ) );
+				}
+			}
+
+			// p^[ZgbN͌JԂ
+			for ( int step = length; step < Sequencer::MAX_STEPS; step++ )
+			{
+				t.steps[ fill ] |= ( ( bits >> ( step % length ) ) & 1u ) << step;
+				t.velocity[ fill ][ step ] = t.velocity[ fill ][ step % length ];
+			}
+		}
+		else if ( command == "bright" )
+		{
+			int index, fill;
+
+			if ( ! ( ss >> index >> fill ) || index < 0 || fill < 0 || fill >= FILLS )
+			{
+				error = "invalid phrase";
+				return false;
+			}
+
+			auto& phrase = at( bright_phrases_, index )[ fill ];
+
+			for ( int step = 0; step < STEPS; step++ )
+			{
+				std::string name;
+
+				if ( ! ( ss >> name ) || ! Tone::from_name( name, phrase[ step ] ) )
+				{
+					error = "invalid tone";
+					return false;
+				}
+			}
+		}
+		else
+		{
+			error = "unknown command : " + command;
+			return false;
+		}
+
+		return true;
+	}
+
+	/// y[WQƂĂp^[ƃt[YSĂ邩ǂ
+	bool validate( std::string& error ) const
+	{
+		for ( int p = 0; p < PAGES; p++ )
+		{
+			if ( rhythm_pattern_[ p ] < 0 || rhythm_pattern_[ p ] >= static_cast< int >( rhythm_patterns_.size() ) ||
+				bright_phrase_[ p ] < 0 || bright_phrase_[ p ] >= static_cast< int >( bright_phrases_.size() ) )
+			{
+				error = std::string( "page " ) + get_page_name( static_cast< Page >( p ) ) + " refers to an undefined pattern";
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+public:
+	Song()
+	{
+		set_default();
+	}
+
+	/// ̋
+	void set_default()
+	{
+		//	{ RPS, FOX,   TAP,   PAD,  BASS,  KICK, SNARE, DEMO,    R,    L,  FREE,  MAX, FIN }
+		part_volume_ = { {
+			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 1.00f, 1.00f, 1.0f, 1.0f, 1.0f, 1.00f, 1.0f, 2.f }, // KICK
+			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 0.00f, 1.00f, 1.0f, 1.0f, 1.0f, 1.00f, 1.0f, 1.f }, // SNARE
+			{ 0.f, 0.f, 0.00f, 0.00f, 0.50f, 0.50f, 0.50f, 1.0f, 1.0f, 1.0f, 1.00f, 1.0f, 0.f }, // BASS
+			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 0.00f, 0.00f, 0.0f, 0.0f, 1.0f, 0.75f, 1.0f, 0.f }, // LEAD_L
+			{ 0.f, 0.f, 0.00f, 0.00f, 0.00f, 0.00f, 0.00f, 0.0f, 1.0f, 1.0f, 0.75f, 1.0f, 0.f }, // LEAD_R
+			{ 0.f, 0.f, 1.00f, 0.25f, 0.00f, 0.00f, 0.00f, 1.0f, 0.0f, 1.0f, 1.00f, 1.0f, 1.f }, // TAP
+			{ 0.f, 0.f, 0.00f, 0.00f, 0.10f, 0.10f, 0.10f, 0.1f, 0.5f, 0.5f, 1.00f, 1.0f, 1.f }, // BRIGHT
+			{ 0.f, 0.f, 0.00f, 0.25f, 0.25f, 0.25f, 0.25f, 0.5f, 0.5f, 0.5f, 0.50f, 0.5f, 0.f }, // PAD
+			{ 1.f },																			 // RPS
+			{ 0.f, 1.f },																		 // FOX
+		} };
+
+		//            KICK  SNARE  BASS  LEAD_L LEAD_R  TAP  BRIGHT  PAD   RPS   FOX
+		part_pan_  = { 0.f, 0.f,   0.f,  -0.5f,  0.5f,  0.f, 0.25f, 0.f,  0.f,  0.f };
+		part_send_ = { 1.f, 1.f,   1.f,   1.f,   1.f,   1.f, 1.f,   1.f,  1.f,  1.f };
+
+		//                { RPS,   FOX,   TAP,   PAD,   BASS,  KICK, SNARE,  DEMO,    R,      L,  FREE,   MAX, FIN }
+		delay_gain_     = { 0.25f, 0.50f, 0.25f, 0.25f, 0.10f, 0.10f, 0.10f, 0.10f, 0.20f, 0.20f, 0.20f, 0.30f, 0.75f };
+		delay_feedback_ = { 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f, 0.50f };
+
+		// ^bv CLIMAX  FINISH ŁAs|̊Ԃɕt_̃GR[Eɑ
+		delay_taps_ = { };
+		delay_taps_[ static_cast< int >( Page::CLIMAX ) ] = { { { 0.75f, 0.30f, -0.7f }, { 1.5f, 0.20f, 0.7f } } };
+		delay_taps_[ static_cast< int >( Page::FINISH ) ] = { { { 0.75f, 0.40f, -0.7f }, { 1.5f, 0.30f, 0.7f }, { 1.25f, 0.20f, -0.3f } } };
+
+		rhythm_pattern_ = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 2, 3 };
+		bright_phrase_  = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2 };
+
+		//                          kick                                        snare
+		rhythm_patterns_ = {
+			make_pattern( "1000100010001010", "1000100010101111",   "0000100000001000", "0100101101011111" ),
+			make_pattern( "1001100110011010", "1001100110011111",   "0000100001001000", "0000110111011111" ),
+			make_pattern( "1001100110011010", "1111111111111111",   "0000100101001000", "0000100101001111" ),
+			make_pattern( "1000000000000000", "0000000000000000",   "1000000000000000", "0000000000000000" ),
+		};
+
+		bright_phrases_ = {
+			Phrase { {
+				{ Tone::C5, Tone::__, Tone::G5, Tone::__,  Tone::C6, Tone::__, Tone::C5, Tone::G5,  Tone::__, Tone::C6, Tone::__, Tone::C6,  Tone::G5, Tone::__, Tone::C6, Tone::__, },
+				{ Tone::C5, Tone::__, Tone::G5, Tone::__,  Tone::C6, Tone::__, Tone::C5, Tone::G5,  Tone::__, Tone::C6, Tone::__, Tone::C6,  Tone::G5, Tone::__, Tone::C6, Tone::__, },
+			} },
+			Phrase { {
+				{ Tone::A5, Tone::__, Tone::G5, Tone::__,  Tone::E5, Tone::__, Tone::D5, Tone::C5,  Tone::__, Tone::D5, Tone::__, Tone::E5,  Tone::D5, Tone::__, Tone::C5, Tone::__, },
+				{ Tone::A5, Tone::__, Tone::G5, Tone::__,  Tone::E5, Tone::__, Tone::D5, Tone::C5,  Tone::__, Tone::D5, Tone::__, Tone::G5,  Tone::D5, Tone::__, Tone::C5, Tone::__, },
+			} },
+			Phrase { {
+				{ Tone::C5, },
+				{ Tone::__, },
+			} },
+		};
+	}
+
+	/**
+	 * Ȃ̃t@Cǂݍ
+	 *
+	 * ǂݍ߂ȂꍇԈႢꍇ́AbZ[W\Ċ̋Ȃɖ߂ false Ԃ
+	 */
+	bool load( const char* file_path )
+	{
+		set_default();
+
+		std::ifstream in( file_path );
+
+		if ( ! in )
+		{
+			std::cout << "could not open : " << file_path << std::endl;
+			return false;
+		}
+
+		std::string line;
+		std::string error;
+		int line_no = 0;
+
+		while ( std::getline( in, line ) )
+		{
+			line_no++;
+
+			if ( ! read_line( line.substr( 0, line.find( '#' ) ), error ) )
+			{
+				std::cout << file_path << "(" << line_no << ") : " << error << std::endl;
+				set_default();
+				return false;
+			}
+		}
+
+		if ( ! validate( error ) )
+		{
+			std::cout << file_path << " : " << error << std::endl;
+			set_default();
+			return false;
+		}
+
+		return true;
+	}
+
+	/// page ̒l PageRow ɂ܂Ƃ߂ ( ̊mۂ͂Ȃ̂ŁAI[fBIXbhĂł悢 )
+	void compile( Page page, PageRow& row ) const
+	{
+		const int p = static_cast< int >( page );
+
+		row.active_parts = 0;
+
+		for ( int n = 0; n < PARTS; n++ )
+		{
+			row.part_volume[ n ] = part_volume_[ n ][ p ];
+
+			if ( row.part_volume[ n ] != 0.f )
+			{
+				row.active_parts |= 1u << n;
+			}
+		}
+
+		row.part_pan = part_pan_;
+		row.part_send = part_send_;
+
+		row.delay_gain = delay_gain_[ p ];
+		row.delay_feedback = delay_feedback_[ p ];
+		row.delay_taps = delay_taps_[ p ];
+
+		Sequencer::compile( rhythm_patterns_[ rhythm_pattern_[ p ] ], row.rhythm );
+		row.bright = bright_phrases_[ bright_phrase_[ p ] ];
+	}
+
+}; // class Song
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * 16 ̓̃t[ʒu𐔂NbN
+ *
+ * n Ԗڂ̃Xebv ceil( n * t[ / Xebv ) ̃t[Ŕ
+ * Xebv̈ʒu͊JnʒȕZŋ߂̂ŁAԓĂ덷~ςȂ
+ *
+ * ubNPʂŃ_Oꍇ split() ŃubÑXebv̈ʒu܂Ƃ߂ċ߁A
+ * TvPʂŃ_Oꍇ tick() 𖈃TvĂ
+ */
+class StepClock
+{
+private:
+	double frames_per_step_ = 1.0;
+
+	int64_t frame_ = 0;				/// ɏt[̈ʒu
+	int64_t next_step_frame_ = 0;	/// ̃Xebṽt[̈ʒu
+
+	int64_t anchor_frame_ = 0;		/// Xebv̈ʒuvZ̃t[
+	int64_t step_ = 0;				/// ̃Xebv anchor_frame_ 琔ĉԖڂ
+
+	void advance_step()
+	{
+		step_++;
+		next_step_frame_ = anchor_frame_ + static_cast< int64_t >( std::ceil( static_cast< double >( step_ ) * frames_per_step_ ) );
+	}
+
+public:
+	StepClock() { }
+
+	explicit StepClock( double frames_per_step )
+	{
+		set_frames_per_step( frames_per_step );
+	}
+
+	/**
+	 * Xebv̒ύX
+	 *
+	 * Ɍ܂Ă鎟̃Xebv̈ʒu͕ςA̎̃XebvVŐ
+	 */
+	void set_frames_per_step( double frames_per_step )
+	{
+		assert( frames_per_step >= 1.0 );
+
+		frames_per_step_ = frames_per_step;
+		anchor_frame_ = next_step_frame_;
+		step_ = 0;
+	}
+
+	double get_frames_per_step() const { return frames_per_step_; }
+
+	/// ɏt[̈ʒu
+	int64_t get_frame() const { return frame_; }
+
+	/// ̃t[ŏ̃XebvƂĂ蒼
+	void reset()
+	{
+		next_step_frame_ = frame_;
+		anchor_frame_ = frame_;
+		step_ = 0;
+	}
+
+	/**
+	 * 1 t[i߂
+	 *
+	 * @return i߂Õt[Xebv̓ǂ
+	 */
+	bool tick()
+	{
+		const bool is_step = frame_ == next_step_frame_;
+
+		if ( is_step )
+		{
+			advance_step();
+		}
+
+		frame_++;
+
+		return is_step;
+	}
+
+	/**
+	 * frames t[i߁ÅԂɂXebv̓̃ubNł̈ʒu offsets ɏo
+	 *
+	 * frames_per_step >= 1 Ȃ̂ŁAoffsets ɂ frames ̗̈悪Α
+	 *
+	 * @return oXebv̐
+	 */
+	int split( int frames, int* offsets )
+	{
+		const int64_t end = frame_ + frames;
+
+		int count = 0;
+
+		while ( next_step_frame_ < end )
+		{
+			offsets[ count++ ] = static_cast< int >( next_step_frame_ - frame_ );
+			advance_step();
+		}
+
+		frame_ = end;
+
+		return count;
+	}
+
+}; // class StepClock
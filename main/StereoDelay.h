@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+/**
+ * e|ɍ킹XeĨs|fBC
+ *
+ * ̃Cɂ̓ZhƃtB[hobNȄo͂AẼCɂ̓tB[hobN̏o͂ނ̂ŁA
+ * GR[͍EɌ݂ɕԂĂ ( E𑫂ƁAȑÕm̃fBCƓԊuƌɂȂ )
+ * X MAX_TAPS ܂ł̃tB[hobNȂ^bvAŎw肵ʒuʂtđ
+ *
+ * Oobt@̒ 2 ̗ݏȂ̂ŁAʒu̓}XNŋ߂BC^bvǂݏo͐`Ԃ
+ * fBC^CE^bv̈ʒuEʁEtB[hobN͐Vl֊炩Ɉڂ̂ŁAe|y[WςĂv`mCYoȂ
+ *
+ * process() ̓ubN̍ŏɏI̒l߂āAubN̒͒ŕԂ
+ * ( 1 TvĂ񂾏ꍇ̓Tvɒǂ̂ƓɂȂ )
+ * ݈ʒuOobt@̏I[܂ȂԖɂ܂Ƃ߂ď
+ *  set_frames_per_second() ŊmۂAprocess() ł͊mۂȂ
+ */
+class StereoDelay
+{
+public:
+	static const int MAX_TAPS = 4;
+
+	constexpr static float TIME_SPEED = 0.5f;			///< fBC^CVlֈڂ鑬 ( 1 b̕b )
+	constexpr static float SMOOTHING_TIME = 0.02f;		///< ʂƃtB[hobNVlֈڂ萔 ( b )
+
+	/// tB[hobNȂ^bv
+	struct Tap
+	{
+		float beats = 0.f;		///< 
+		float gain = 0.f;		///< 0 ȂgȂ
+		float pan = 0.f;		///< -1 :  .. 1 : E
+	};
+
+private:
+	constexpr static float SILENT_GAIN = 0.00001f;		/// ^bv̗ʂAڕW 0 Ȃ珈Ȃ
+
+	std::vector< float > line_l_;
+	std::vector< float > line_r_;
+	std::vector< float > input_;	/// ^bvǂރZh ( ʂ| )
+	int mask_ = 0;
+	int write_ = 0;
+
+	double frames_per_second_ = 44100.0;
+	double frames_per_beat_ = 22050.0;
+
+	float beats_ = 0.5f;			/// s|̃fBC^C (  )
+	float time_ = 0.f;				/// ݂̃fBC^C ( Tv )
+	float target_time_ = 0.f;
+	float time_speed_ = 0.f;		/// 1 TvɃfBC^CTv
+
+	float gain_ = 0.f, target_gain_ = 0.f;
+	float feedback_ = 0.f, target_feedback_ = 0.f;
+	float smoothing_ = 0.f;			/// ʂƃtB[hobNǂW
+
+	std::array< Tap, MAX_TAPS > taps_;
+	std::array< float, MAX_TAPS > tap_time_ = { };			/// ݂̃^bv̈ʒu ( Tv )
+	std::array< float, MAX_TAPS > tap_target_time_ = { };
+	std::array< float, MAX_TAPS > tap_gain_l_ = { };
+	std::array< float, MAX_TAPS > tap_gain_r_ = { };
+	std::array< float, MAX_TAPS > tap_target_gain_l_ = { };
+	std::array< float, MAX_TAPS > tap_target_gain_r_ = { };
+
+	float max_time_ = 0.f;			/// ǂݏoő̃fBC^C ( Tv )
+
+	/// time TvO`Ԃēǂ
+	static float read( const float* line, int mask, int write, float time )
+	{
+		const int whole = static_cast< int >( time );
+		const float fraction = time - whole;
+
+		const float a = line[ ( write - whole ) & mask ];
+		const float b = line[ ( write - whole - 1 ) & mask ];
+
+		return a + ( b - a ) * fraction;
+	}
+
+	/// frames Tv̎Ԃ̈ʒu ( speed  target ֒ňڂ )
+	float glide( float time, float target, int frames ) const
+	{
+		const float limit = time_speed_ * frames;
+
+		return time + std::min( std::max( target - time, -limit ), limit );
+	}
+
+	/// frames Tv̗ ( smoothing_  target ǂ )
+	static float smooth( float value, float target, float decay )
+	{
+		return target + ( value - target ) * decay;
+	}
+
+	bool is_tap_active( int n ) const
+	{
+		return tap_target_gain_l_[ n ] != 0.f || tap_target_gain_r_[ n ] != 0.f ||
+			std::abs( tap_gain_l_[ n ] ) > SILENT_GAIN || std::abs( tap_gain_r_[ n ] ) > SILENT_GAIN;
+	}
+
+	void update_time()
+	{
+		target_time_ = std::min( static_cast< float >( beats_ * frames_per_beat_ ), max_time_ );
+
+		for ( int n = 0; n < MAX_TAPS; n++ )
+		{
+			const Tap& tap = taps_[ n ];
+
+			// p[̒
+			const float angle = ( std::min( std::max( tap.pan, -1.f ), 1.f ) + 1.f ) * 0.25f * 3.14159265f;
+
+			tap_target_time_[ n ] = std::min( std::max( static_cast< float >( tap.beats * frames_per_beat_ ), 1.f ), max_time_ );
+			tap_target_gain_l_[ n ] = tap.gain * std::cos( angle );
+			tap_target_gain_r_[ n ] = tap.gain * std::sin( angle );
+		}
+	}
+
+public:
+	/**
+	 * TvO[gƍő̃fBC^C ( b ) ߂āAOobt@mۂ
+	 *
+	 * I[fBIXbhĂ΂Ȃ
+	 */
+	void set_frames_per_second( double frames_per_second, double max_seconds )
+	{
+		frames_per_second_ = frames_per_second;
+
+		int size = 1;
+
+		while ( size < static_cast< int >( max_seconds * frames_per_second ) + 2 )
+		{
+			size <<= 1;
+		}
+
+		line_l_.assign( size, 0.f );
+		line_r_.assign( size, 0.f );
+		input_.assign( size, 0.f );
+		mask_ = size - 1;
+		write_ = 0;
+
+		max_time_ = static_cast< float >( size - 2 );
+		time_speed_ = TIME_SPEED;	// 1 b̕bȂ̂ŁATvłlɂȂ
+		smoothing_ = static_cast< float >( 1.0 - std::exp( -1.0 / ( SMOOTHING_TIME * frames_per_second ) ) );
+
+		update_time();
+		time_ = target_time_;
+		tap_time_ = tap_target_time_;
+	}
+
+	/// e|ςBfBC^Cƃ^bv̈ʒu TIME_SPEED ŐVlֈڂ
+	void set_bpm( double bpm )
+	{
+		frames_per_beat_ = frames_per_second_ * 60.0 / bpm;
+		update_time();
+	}
+
+	/// s|̃fBC^C𔏂Ŏw肷
+	void set_beats( float beats )
+	{
+		beats_ = beats;
+		update_time();
+	}
+
+	/// ^bvς ( ̊mۂ͂Ȃ̂ŁAI[fBIXbhĂł悢 )
+	void set_tap( int index, const Tap& tap )
+	{
+		taps_[ index ] = tap;
+		update_time();
+	}
+
+	/// ʂƃtB[hobN̖ڕWlς
+	void set_gain( float gain ) { target_gain_ = gain; }
+	void set_feedback( float feedback ) { target_feedback_ = feedback; }
+
+	/// ʂƃtB[hobNƃfBC^Cƃ^bvڕWlɑ
+	void fit()
+	{
+		gain_ = target_gain_;
+		feedback_ = target_feedback_;
+		time_ = target_time_;
+		tap_time_ = tap_target_time_;
+		tap_gain_l_ = tap_target_gain_l_;
+		tap_gain_r_ = tap_target_gain_r_;
+	}
+
+	float get_time() const { return time_; }
+	float get_tap_time( int index ) const { return tap_time_[ index ]; }
+
+	/// 1 TvAsend GR[ l  r ɑ
+	void process( float send, float& l, float& r )
+	{
+		process( & send, & l, & r, 1 );
+	}
+
+	/// frames TvAsend GR[ l  r ɑ
+	void process( const float* send, float* l, float* r, int frames )
+	{
+		if ( frames <= 0 )
+		{
+			return;
+		}
+
+		// ubN̏I̒lx߁ATv̑ɂ
+		const float decay = std::pow( 1.f - smoothing_, static_cast< float >( frames ) );
+		const float inverse = 1.f / frames;
+
+		const float gain_step = ( smooth( gain_, target_gain_, decay ) - gain_ ) * inverse;
+		const float feedback_step = ( smooth( feedback_, target_feedback_, decay ) - feedback_ ) * inverse;
+		const float time_step = ( glide( time_, target_time_, frames ) - time_ ) * inverse;
+
+		float* line_l = & line_l_[ 0 ];
+		float* line_r = & line_r_[ 0 ];
+		float* input = & input_[ 0 ];
+		const int mask = mask_;
+
+		float gain = gain_, feedback = feedback_, time = time_;
+
+		for ( int begin = 0, write = write_; begin < frames; )
+		{
+			// ݈ʒuOobt@̏I[܂Ȃ
+			const int run = std::min( frames - begin, mask + 1 - write );
+
+			for ( int n = 0; n < run; n++ )
+			{
+				gain += gain_step;
+				feedback += feedback_step;
+				time += time_step;
+
+				const float echo_l = read( line_l, mask, write + n, time );
+				const float echo_r = read( line_r, mask, write + n, time );
+				const float s = send[ begin + n ] * gain;
+
+				line_l[ write + n ] = s + echo_r * feedback;
+				line_r[ write + n ] = echo_l * feedback;
+				input[ write + n ] = s;
+
+				l[ begin + n ] += echo_l;
+				r[ begin + n ] += echo_r;
+			}
+
+			begin += run;
+			write = ( write + run ) & mask;
+		}
+
+		// ^bv̓Zhǂނ̂ŁACƂ͕ʂɃ^bvɂ܂Ƃ߂đ
+		for ( int t = 0; t < MAX_TAPS; t++ )
+		{
+			if ( ! is_tap_active( t ) )
+			{
+				tap_gain_l_[ t ] = tap_gain_r_[ t ] = 0.f;
+				tap_time_[ t ] = tap_target_time_[ t ];
+				continue;
+			}
+
+			const float tap_time_step = ( glide( tap_time_[ t ], tap_target_time_[ t ], frames ) - tap_time_[ t ] ) * inverse;
+			const float tap_gain_l_step = ( smooth( tap_gain_l_[ t ], tap_target_gain_l_[ t ], decay ) - tap_gain_l_[ t ] ) * inverse;
+			const float tap_gain_r_step = ( smooth( tap_gain_r_[ t ], tap_target_gain_r_[ t ], decay ) - tap_gain_r_[ t ] ) * inverse;
+
+			float tap_time = tap_time_[ t ], tap_gain_l = tap_gain_l_[ t ], tap_gain_r = tap_gain_r_[ t ];
+
+			for ( int begin = 0, write = write_; begin < frames; )
+			{
+				const int run = std::min( frames - begin, mask + 1 - write );
+
+				for ( int n = 0; n < run; n++ )
+				{
+					tap_time += tap_time_step;
+					tap_gain_l += tap_gain_l_step;
+					tap_gain_r += tap_gain_r_step;
+
+					const float tap = read( input, mask, write + n, tap_time );
+
+					l[ begin + n ] += tap * tap_gain_l;
+					r[ begin + n ] += tap * tap_gain_r;
+				}
+
+				begin += run;
+				write = ( write + run ) & mask;
+			}
+
+			tap_time_[ t ] = tap_time;
+			tap_gain_l_[ t ] = tap_gain_l;
+			tap_gain_r_[ t ] = tap_gain_r;
+		}
+
+		gain_ = gain;
+		feedback_ = feedback;
+		time_ = time;
+		write_ = ( write_ + frames ) & mask;
+	}
+
+}; // class StereoDelay
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "spsc_queue.h"
+#include "locked_buffer.h"
+#include "LoopFinder.h"
+#include "PitchDetector.h"
+#include "Tone.h"
+
+#include <Gamma/Containers.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * ^eCNƂĎg悤ɉH郏[J[
+ *
+ * I[fBIXbh͘^̊ capture() œ͂Oobt@ɃRs[A^I submit() 邾
+ * KĚoE[v_̌oƃNXtF[h̓[J[XbhōsAoオ Take I[fBIXbhɕԂ
+ * I[fBIXbhgI Take  retire() Ń[J[ɕԂA[J[Xbhŉ
+ */
+class TakeProcessor
+{
+public:
+	/// eCN̎g
+	enum class Slot
+	{
+		KICK = 0,
+		SNARE,
+		TAP,
+		TONE,		///< x[XE[hEpbhȂǂ̉̂鉹
+		MAX
+	};
+
+	/// Hς݂̃eCN
+	struct Take
+	{
+		Slot slot;
+		std::vector< float > samples;
+		float frequency = 0.f;		///< o{g ( TONE ̂݁B߂Ȃ 0 )
+		float tuning = 1.f;			///< rate()  1 ̎ Tone::C3 Ŗ悤ɁATvO[gɊ|l
+		int loop_begin = 0;			///< [vĐ͈ ( TONE ̂ )
+		int loop_end = 0;
+	};
+
+	static const int MIN_FRAMES = 64;			///< ^Zꍇ͂̒ɂ
+	static const int POLL_INTERVAL_MS = 5;
+
+private:
+	/// I[fBIXbh烏[J[ւ̈˗
+	struct Request
+	{
+		Slot slot;
+		int64_t start;		///< Oobt@̘^̊Jnʒu
+		int frames;
+	};
+
+	/**
+	 * ^p̃Oobt@
+	 *
+	 * łeCN 2 {̒̂ŁA[J[ÕeCNǂݏIOɎ̘^n߂Ă㏑Ȃ
+	 */
+	common::locked_buffer< float > ring_;
+	int max_take_frames_;
+	int take_frames_;					/// I[fBIXbh : ݂̃e|ł 1 ̘^̍őt[ ( max_take_frames_ ȉ )
+
+	int64_t write_position_ = 0;		/// I[fBIXbh : Oobt@ɏ񂾑t[
+	int64_t capture_start_ = 0;			/// I[fBIXbh : ^̃eCN̊Jnʒu
+	int capture_frames_ = 0;			/// I[fBIXbh : ^̃eCÑt[
+
+	std::atomic< int > pending_count_;	/// submit() Ă܂[J[ǂݏIĂȂeCN̐
+
+	common::spsc_queue< Request, 8 > requests_;		/// I[fBIXbh  [J[
+	common::spsc_queue< Take*, 8 > ready_;			/// [J[  I[fBIXbh
+	common::spsc_queue< Take*, 16 > retired_;		/// I[fBIXbh  [J[
+
+	std::thread thread_;
+	std::atomic< bool > is_running_;
+
+	PitchDetector pitch_;			/// [J[ : ̌o ( Ɨp̃obt@g )
+	LoopFinder loop_finder_;		/// [J[ : [v_̌o
+
+	Take* prepare( const Request& request )
+	{
+		Take* take = new Take();
+		take->slot = request.slot;
+
+		take->samples.assign( std::max( request.frames, static_cast< int >( MIN_FRAMES ) ), 0.f );
+		read_ring( request.start, & take->samples[ 0 ], request.frames );
+
+		pending_count_--;
+
+		gam::arr::normalize( & take->samples[ 0 ], static_cast< uint32_t >( take->samples.size() ) );
+
+		if ( take->slot == Slot::TONE )
+		{
+			const int frames = static_cast< int >( take->samples.size() );
+
+			// NXtF[hŔg`Oɉ𒲂ׂ
+			take->frequency = pitch_.detect( & take->samples[ 0 ], frames );
+			take->tuning = take->frequency > 0.f ? Tone::C3 / take->frequency : 1.f;
+
+			const LoopFinder::Loop loop = loop_finder_.find( & take->samples[ 0 ], frames );
+			LoopFinder::apply( & take->samples[ 0 ], loop );
+
+			take->loop_begin = loop.begin;
+			take->loop_end = loop.end;
+
+			std::cout << "tone : " << take->frequency << " Hz, loop : " << loop.begin << " .. " << loop.end << " ( " << loop.score << " )" << std::endl;
+		}
+
+		return take;
+	}
+
+	void read_ring( int64_t position, float* dst, int frames ) const
+	{
+		const int offset = static_cast< int >( position % static_cast< int64_t >( ring_.size() ) );
+		const int first = std::min( frames, static_cast< int >( ring_.size() ) - offset );
+
+		std::memcpy( dst, ring_.data() + offset, sizeof( float ) * first );
+		std::memcpy( dst + first, ring_.data(), sizeof( float ) * ( frames - first ) );
+	}
+
+	void write_ring( int64_t position, const float* src, int frames )
+	{
+		const int offset = static_cast< int >( position % static_cast< int64_t >( ring_.size() ) );
+		const int first = std::min( frames, static_cast< int >( ring_.size() ) - offset );
+
+		std::memcpy( ring_.data() + offset, src, sizeof( float ) * first );
+		std::memcpy( ring_.data(), src + first, sizeof( float ) * ( frames - first ) );
+	}
+
+	void work()
+	{
+		Take* take;
+
+		while ( retired_.pop( take ) )
+		{
+			delete take;
+		}
+
+		Request request;
+
+		while ( requests_.pop( request ) )
+		{
+			take = prepare( request );
+
+			while ( ! ready_.push( take ) )
+			{
+				// ~߂ĂԂ flush() ł͑҂Ă󂩂Ȃ̂Ŏ̂Ă
+				if ( ! is_running_ )
+				{
+					delete take;
+					break;
+				}
+
+				std::this_thread::sleep_for( std::chrono::milliseconds( POLL_INTERVAL_MS ) );
+			}
+		}
+	}
+
+public:
+	/// max_take_frames : 1 ̘^̍őt[ ( e|ςĂ𒴂Ȃ )
+	TakeProcessor( int max_take_frames, double frames_per_second )
+		: ring_( static_cast< size_t >( max_take_frames ) * 2 )
+		, max_take_frames_( max_take_frames )
+		, take_frames_( max_take_frames )
+		, pending_count_( 0 )
+		, is_running_( false )
+		, pitch_( frames_per_second )
+		, loop_finder_( frames_per_second )
+	{
+		if ( ! ring_.is_locked() )
+		{
+			std::cout << "could not lock the recording buffer." << std::endl;
+		}
+	}
+
+	~TakeProcessor()
+	{
+		stop();
+
+		Take* take;
+
+		while ( ready_.pop( take ) )
+		{
+			delete take;
+		}
+
+		while ( retired_.pop( take ) )
+		{
+			delete take;
+		}
+	}
+
+	void start()
+	{
+		if ( is_running_ )
+		{
+			return;
+		}
+
+		is_running_ = true;
+
+		thread_ = std::thread( [this] () {
+			while ( is_running_ )
+			{
+				work();
+
+				std::this_thread::sleep_for( std::chrono::milliseconds( POLL_INTERVAL_MS ) );
+			}
+		} );
+	}
+
+	void stop()
+	{
+		is_running_ = false;
+
+		if ( thread_.joinable() )
+		{
+			thread_.join();
+		}
+	}
+
+	/**
+	 * [J[Xbh start() ĂȂꍇɁA˗ꂽeCN̏ŉH
+	 *
+	 * ItC_Oł́AeCNւXebvԂŕςȂ悤ɁA
+	 * ubNɂĂŃ[J[̑ɉHBԂĂ pending_count_  0 ɂȂĂ
+	 */
+	void flush()
+	{
+		if ( is_running_ )
+		{
+			return;
+		}
+
+		work();
+	}
+
+	/**
+	 * I[fBIXbh : ^n߂
+	 *
+	 * [J[܂ǂݏIĂȂeCN㏑Ă܂ꍇ́A^ false Ԃ
+	 */
+	bool begin_capture()
+	{
+		if ( pending_count_ > 1 )
+		{
+			return false;
+		}
+
+		capture_start_ = write_position_;
+		capture_frames_ = 0;
+
+		return true;
+	}
+
+	/**
+	 * I[fBIXbh : 1 ubN̓͂^
+	 *
+	 * őt[𒴂͎̂ĂBOobt@̏I[܂ꍇȊO 1  memcpy ōς
+	 */
+	void capture( const float* in, int frames )
+	{
+		frames = std::min( frames, take_frames_ - capture_frames_ );
+
+		if ( frames <= 0 )
+		{
+			return;
+		}
+
+		write_ring( write_position_, in, frames );
+
+		write_position_ += frames;
+		capture_frames_ += frames;
+	}
+
+	/// I[fBIXbh : ^̃eCÑt[
+	int get_capture_frames() const { return capture_frames_; }
+	int get_max_take_frames() const { return max_take_frames_; }
+
+	/// I[fBIXbh : 1 ̘^̒e|ɍ킹ĕς ( Oobt@͍蒼Ȃ )
+	void set_take_frames( int frames ) { take_frames_ = std::min( std::max( frames, 1 ), max_take_frames_ ); }
+	int get_take_frames() const { return take_frames_; }
+
+	/// I[fBIXbh : ^eCN̉H[J[Ɉ˗
+	bool submit( Slot slot )
+	{
+		pending_count_++;
+
+		if ( ! requests_.push( Request { slot, capture_start_, capture_frames_ } ) )
+		{
+			pending_count_--;
+			return false;
+		}
+
+		return true;
+	}
+
+	/// I[fBIXbh : Hς݂̃eCNΎo
+	Take* poll()
+	{
+		Take* take = nullptr;
+		ready_.pop( take );
+
+		return take;
+	}
+
+	/**
+	 * I[fBIXbh : QƂĂȂeCNԂ
+	 *
+	 * ̓[J[XbhōsBL[t̏ꍇ͉ɒ߂
+	 */
+	void retire( Take* take )
+	{
+		if ( take )
+		{
+			retired_.push( take );
+		}
+	}
+
+}; // class TakeProcessor
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cmath>
+#include <string>
+
 class Tone
 {
 public:
@@ -47,4 +50,50 @@ public:
 	constexpr static const float C7 = 2093.005f;
 								    
 	constexpr static const float __ = 0.f;
+
+	/**
+	 * "C4"  "F#3" ̂悤ȉ̎g ( A4 = 440 Hz ̕ϗA̒萔Ɠ_ȉ 3  )
+	 *
+	 * "-" ͋x ( __ ) ƂBƂēǂ߂Ȃ false Ԃ
+	 */
+	static bool from_name( const std::string& name, float& tone )
+	{
+		if ( name == "-" )
+		{
+			tone = __;
+			return true;
+		}
+
+		static const int semitones[] = { 9, 11, 0, 2, 4, 5, 7 }; // A B C D E F G
+
+		if ( name.size() < 2 || name[ 0 ] < 'A' || name[ 0 ] > 'G' )
+		{
+			return false;
+		}
+
+		int note = semitones[ name[ 0 ] - 'A' ];
+		size_t n = 1;
+
+		if ( name[ n ] == '#' )
+		{
+			note++;
+			n++;
+		}
+		else if ( name[ n ] == 'b' )
+		{
+			note--;
+			n++;
+		}
+
+		if ( n + 1 != name.size() || name[ n ] < '0' || name[ n ] > '9' )
+		{
+			return false;
+		}
+
+		const int midi = ( name[ n ] - '0' + 1 ) * 12 + note;
+
+		tone = static_cast< float >( std::round( 440.0 * std::pow( 2.0, ( midi - 69 ) / 12.0 ) * 1000.0 ) / 1000.0 );
+
+		return true;
+	}
 };
\ No newline at end of file
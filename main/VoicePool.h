@@ -0,0 +1,299 @@
+#pragma once
+
+#include "dsp.h"
+
+#include <Gamma/Envelope.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * d˂Ė炷߂̃{CX̏W܂
+ *
+ * {CX͍ŏ N ĂAtrigger() ŋ󂢂Ă{CX蓖Ă ( ̊mۂ͂Ȃ )
+ * 󂢂Ă{CXꍇ͍łÂ{CXD
+ *
+ * D{CXI{CX̍Ō̏o͂́AZȂ瑫̂ŁAr؂ꂽŃmCYoȂ
+ * Ă{CX̔ԍl߂ĎĂ̂ŁAĂȂ΃_O̔p͂Ȃ
+ */
+template< typename Player, int N >
+class VoicePool
+{
+public:
+	struct Voice
+	{
+		Player player;
+		gam::AD<> envelope;
+		float gain = 1.f;
+		int delay = 0;			///< n߂܂ł̃Tv
+
+		/// n߂ ( player  range()  rate() ݒ肵ĂĂ )
+		void start()
+		{
+			start( 1.f, 0 );
+		}
+
+		///  velocity  delay_frames Tvォ甭n߂
+		void start( float velocity, int delay_frames )
+		{
+			player.reset();
+			envelope.reset();
+			gain = velocity;
+			delay = delay_frames;
+		}
+
+		bool done() const { return player.done() || envelope.done(); }
+
+		float operator()()
+		{
+			if ( delay > 0 )
+			{
+				delay--;
+				return 0.f;
+			}
+
+			return player() * envelope() * gain;
+		}
+
+		/// _O frames Tvi߂
+		void skip( int frames, double frames_per_second )
+		{
+			const int wait = std::min( delay, frames );
+
+			delay -= wait;
+			frames -= wait;
+
+			player.pos( std::min( player.pos() + frames * player.rate() * player.frameRate() / frames_per_second, player.max() ) );
+
+			for ( int n = 0; n < frames; n++ )
+			{
+				envelope();
+			}
+		}
+	};
+
+	static const int CAPACITY = N;
+
+	/// r؂ꂽ{CX̏o͂鎞萔 ( b )B44.1 kHz  1 Tv 0.99 {ɂȂ
+	constexpr static float DECLICK_TIME = 0.00226f;
+	constexpr static float DECLICK_THRESHOLD = 0.00001f;
+
+private:
+	std::array< Voice, N > voices_;
+
+	std::array< int, N > active_;		/// Ă{CX̔ԍ ( 擪 active_count_  )
+	std::array< int, N > free_;			/// 󂢂Ă{CX̔ԍ ( 擪 free_count_  )
+	int active_count_ = 0;
+	int free_count_ = N;
+
+	std::array< uint64_t, N > serial_ = { };	/// {CX蓖Ă
+	std::array< float, N > last_ = { };			/// {CX̍Ō̏o
+	uint64_t next_serial_ = 0;
+
+	float declick_ = 0.f;				/// r؂ꂽ{CX̏o͂̎c
+	float declick_coefficient_ = 0.99f;	/// r؂ꂽ{CX̏o͂ 1 TvɌW
+
+	/// active_  i Ԗڂ̃{CX~߂ċ󂫂ɖ߂
+	void release( int i )
+	{
+		const int index = active_[ i ];
+
+		declick_ += last_[ index ];
+		last_[ index ] = 0.f;
+
+		active_[ i ] = active_[ --active_count_ ];
+		free_[ free_count_++ ] = index;
+	}
+
+	float next_declick()
+	{
+		const float s = declick_;
+
+		declick_ = std::abs( declick_ ) > DECLICK_THRESHOLD ? declick_ * declick_coefficient_ : 0.f;
+
+		return s;
+	}
+
+public:
+	VoicePool( float attack, float decay )
+	{
+		for ( int n = 0; n < N; n++ )
+		{
+			voices_[ n ].envelope.attack( attack );
+			voices_[ n ].envelope.decay( decay );
+
+			free_[ n ] = N - 1 - n;
+		}
+	}
+
+	/// TvO[g猸̌W߂
+	void set_frames_per_second( double frames_per_second )
+	{
+		declick_coefficient_ = static_cast< float >( std::exp( -1.0 / ( DECLICK_TIME * frames_per_second ) ) );
+	}
+
+	/// SẴ{CX̉Õɍւ ( ̊mۂ͂Ȃ )
+	void buffer( float* samples, int frames, double frame_rate, int channels )
+	{
+		for ( auto& voice : voices_ )
+		{
+			voice.player.buffer( samples, frames, frame_rate, channels );
+		}
+	}
+
+	/**
+	 * {CX 1 蓖Ă
+	 *
+	 * Ԃ{CX͖Ă{CXƂĈ̂ŁAȂǂݒ肵Ă Voice::start() ĂԂ
+	 */
+	Voice& trigger()
+	{
+		if ( free_count_ == 0 )
+		{
+			int oldest = 0;
+
+			for ( int i = 1; i < active_count_; i++ )
+			{
+				if ( serial_[ active_[ i ] ] < serial_[ active_[ oldest ] ] )
+				{
+					oldest = i;
+				}
+			}
+
+			release( oldest );
+		}
+
+		const int index = free_[ --free_count_ ];
+
+		active_[ active_count_++ ] = index;
+		serial_[ index ] = next_serial_++;
+		last_[ index ] = 0.f;
+
+		return voices_[ index ];
+	}
+
+	int get_active_count() const { return active_count_; }
+
+	/// Ă{CXSĎ~߂
+	void stop()
+	{
+		while ( active_count_ > 0 )
+		{
+			release( active_count_ - 1 );
+		}
+	}
+
+	/**
+	 * Ă{CX frames Tv_O out ɏo
+	 *
+	 * I{CX̓ubN̍Ōŋ󂫂ɖ߂
+	 */
+	void render( float* out, int frames )
+	{
+		dsp::clear( out, frames );
+
+		// ̃ubNŖI{CX̎c͎̃ubN瑫
+		float declick = declick_;
+		declick_ = 0.f;
+
+		if ( declick != 0.f )
+		{
+			for ( int n = 0; n < frames; n++ )
+			{
+				out[ n ] = declick;
+				declick *= declick_coefficient_;
+			}
+
+			if ( std::abs( declick ) > DECLICK_THRESHOLD )
+			{
+				declick_ = declick;
+			}
+		}
+
+		for ( int i = 0; i < active_count_; )
+		{
+			const int index = active_[ i ];
+			Voice& voice = voices_[ index ];
+
+			float s = last_[ index ];
+
+			// ̓x点Ă{CX͂̕΂
+			const int wait = std::min( voice.delay, frames );
+			voice.delay -= wait;
+
+			for ( int n = wait; n < frames; n++ )
+			{
+				s = voice.player() * voice.envelope() * voice.gain;
+				out[ n ] += s;
+			}
+
+			last_[ index ] = s;
+
+			if ( voice.done() )
+			{
+				release( i );
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	/**
+	 * o͂ȂԁAĂ{CX frames Tv_Oɐi߂
+	 *
+	 * Đʒu͌vZŐi߂̂ŁAĂѕ悤ɂȂɓr
+	 */
+	void skip( int frames, double frames_per_second )
+	{
+		declick_ = 0.f;
+
+		for ( int i = 0; i < active_count_; )
+		{
+			const int index = active_[ i ];
+			Voice& voice = voices_[ index ];
+
+			voice.skip( frames, frames_per_second );
+			last_[ index ] = 0.f;
+
+			if ( voice.done() )
+			{
+				release( i );
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	/// 1 Tv_O ( QƎp )
+	float operator()()
+	{
+		float s = next_declick();
+
+		for ( int i = 0; i < active_count_; )
+		{
+			const int index = active_[ i ];
+			Voice& voice = voices_[ index ];
+
+			last_[ index ] = voice();
+			s += last_[ index ];
+
+			if ( voice.done() )
+			{
+				release( i );
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		return s;
+	}
+
+}; // class VoicePool
@@ -2,6 +2,10 @@
 #define COMMON_CHASE_VALUE_H
 
 #include "math.h"
+#include "dsp.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace common
 {
@@ -33,6 +37,45 @@ public:
 		value_ = math::chase( value_, target_value_, speed );
 	}
 
+	/**
+	 * chase()  frames sAe̒l out ɏo
+	 *
+	 * ڕWlɓB܂ł͒̃v܂Ƃ߂ċ߁AB͖ڕWlŖ߂
+	 */
+	void chase( Type* out, int frames )
+	{
+		if ( frames <= 0 )
+		{
+			return;
+		}
+
+		if ( value_ == target_value_ || speed_ <= Type( 0 ) )
+		{
+			dsp::fill( out, value_, frames );
+			return;
+		}
+
+		const Type distance = target_value_ - value_;
+		const Type step = distance > Type( 0 ) ? speed_ : -speed_;
+
+		// ڕWlɓB܂ł̃Tv ( BTv܂ )
+		const double ramp_frames = std::ceil( static_cast< double >( distance / step ) );
+
+		if ( ramp_frames > frames )
+		{
+			dsp::ramp( out, value_ + step, step, frames );
+			value_ = out[ frames - 1 ];
+		}
+		else
+		{
+			const int n = std::max( static_cast< int >( ramp_frames ), 1 );
+
+			dsp::ramp( out, value_ + step, step, n - 1 );
+			dsp::fill( out + n - 1, target_value_, frames - n + 1 );
+			value_ = target_value_;
+		}
+	}
+
 	void fit_to_target()
 	{
 		value_ = target_value_;
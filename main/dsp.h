@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __SSE__ )
+#include <xmmintrin.h>
+#define HAND_DSP_SSE
+#endif
+
+/**
+ * ubNPʂ̐MŎgȊ֐Q
+ *
+ * SSE gł 4 TvA[̓XJ[ŏ
+ */
+namespace dsp
+{
+
+/// dst[ n ] = 0
+inline void clear( float* dst, int frames )
+{
+	std::memset( dst, 0, sizeof( float ) * frames );
+}
+
+/// dst[ n ] = value
+inline void fill( float* dst, float value, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	const __m128 v = _mm_set1_ps( value );
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		_mm_storeu_ps( dst + n, v );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n ] = value;
+	}
+}
+
+/// dst[ n ] = src[ n ]
+inline void copy( float* dst, const float* src, int frames )
+{
+	std::memcpy( dst, src, sizeof( float ) * frames );
+}
+
+/// dst[ n ] += src[ n ] * gain
+inline void mul_add( float* dst, const float* src, float gain, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	const __m128 g = _mm_set1_ps( gain );
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		_mm_storeu_ps( dst + n, _mm_add_ps( _mm_loadu_ps( dst + n ), _mm_mul_ps( _mm_loadu_ps( src + n ), g ) ) );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n ] += src[ n ] * gain;
+	}
+}
+
+/// dst[ n ] += src[ n ]
+inline void add( float* dst, const float* src, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		_mm_storeu_ps( dst + n, _mm_add_ps( _mm_loadu_ps( dst + n ), _mm_loadu_ps( src + n ) ) );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n ] += src[ n ];
+	}
+}
+
+/// dst[ n ] *= src[ n ]
+inline void mul( float* dst, const float* src, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		_mm_storeu_ps( dst + n, _mm_mul_ps( _mm_loadu_ps( dst + n ), _mm_loadu_ps( src + n ) ) );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n ] *= src[ n ];
+	}
+}
+
+/// dst[ n ] *= gain
+inline void scale( float* dst, float gain, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	const __m128 g = _mm_set1_ps( gain );
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		_mm_storeu_ps( dst + n, _mm_mul_ps( _mm_loadu_ps( dst + n ), g ) );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n ] *= gain;
+	}
+}
+
+/// src[ n ] ̍v
+inline float sum( const float* src, int frames )
+{
+	int n = 0;
+	float s = 0.f;
+
+#ifdef HAND_DSP_SSE
+	__m128 v = _mm_setzero_ps();
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		v = _mm_add_ps( v, _mm_loadu_ps( src + n ) );
+	}
+
+	float lanes[ 4 ];
+	_mm_storeu_ps( lanes, v );
+
+	s = ( lanes[ 0 ] + lanes[ 1 ] ) + ( lanes[ 2 ] + lanes[ 3 ] );
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		s += src[ n ];
+	}
+
+	return s;
+}
+
+/// a[ n ] * b[ n ] ̍v
+inline float dot( const float* a, const float* b, int frames )
+{
+	int n = 0;
+	float s = 0.f;
+
+#ifdef HAND_DSP_SSE
+	__m128 v = _mm_setzero_ps();
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		v = _mm_add_ps( v, _mm_mul_ps( _mm_loadu_ps( a + n ), _mm_loadu_ps( b + n ) ) );
+	}
+
+	float lanes[ 4 ];
+	_mm_storeu_ps( lanes, v );
+
+	s = ( lanes[ 0 ] + lanes[ 1 ] ) + ( lanes[ 2 ] + lanes[ 3 ] );
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		s += a[ n ] * b[ n ];
+	}
+
+	return s;
+}
+
+/// C^[[uXeI֒ʂtđ : dst[ 2n ] += src[ n ] * gain_l, dst[ 2n + 1 ] += src[ n ] * gain_r
+inline void mul_add_stereo( float* dst, const float* src, float gain_l, float gain_r, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	const __m128 g = _mm_setr_ps( gain_l, gain_r, gain_l, gain_r );
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		const __m128 v = _mm_loadu_ps( src + n );
+
+		_mm_storeu_ps( dst + n * 2,     _mm_add_ps( _mm_loadu_ps( dst + n * 2 ),     _mm_mul_ps( _mm_unpacklo_ps( v, v ), g ) ) );
+		_mm_storeu_ps( dst + n * 2 + 4, _mm_add_ps( _mm_loadu_ps( dst + n * 2 + 4 ), _mm_mul_ps( _mm_unpackhi_ps( v, v ), g ) ) );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n * 2 ] += src[ n ] * gain_l;
+		dst[ n * 2 + 1 ] += src[ n ] * gain_r;
+	}
+}
+
+/// C^[[uXeIEɕ : l[ n ] = src[ 2n ], r[ n ] = src[ 2n + 1 ]
+inline void deinterleave( float* l, float* r, const float* src, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		const __m128 a = _mm_loadu_ps( src + n * 2 );
+		const __m128 b = _mm_loadu_ps( src + n * 2 + 4 );
+
+		_mm_storeu_ps( l + n, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		_mm_storeu_ps( r + n, _mm_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		l[ n ] = src[ n * 2 ];
+		r[ n ] = src[ n * 2 + 1 ];
+	}
+}
+
+/**
+ * Ẽs[N : dst[ n ] = max( | a[ n ] |, | b[ n ] | )
+ *
+ * @return dst ̍ől
+ */
+inline float abs_max( float* dst, const float* a, const float* b, int frames )
+{
+	int n = 0;
+	float peak = 0.f;
+
+#ifdef HAND_DSP_SSE
+	const __m128 sign = _mm_set1_ps( -0.f );
+	__m128 m = _mm_setzero_ps();
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		const __m128 v = _mm_max_ps( _mm_andnot_ps( sign, _mm_loadu_ps( a + n ) ), _mm_andnot_ps( sign, _mm_loadu_ps( b + n ) ) );
+		_mm_storeu_ps( dst + n, v );
+		m = _mm_max_ps( m, v );
+	}
+
+	float lanes[ 4 ];
+	_mm_storeu_ps( lanes, m );
+
+	peak = std::max( std::max( lanes[ 0 ], lanes[ 1 ] ), std::max( lanes[ 2 ], lanes[ 3 ] ) );
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n ] = std::max( std::abs( a[ n ] ), std::abs( b[ n ] ) );
+		peak = std::max( peak, dst[ n ] );
+	}
+
+	return peak;
+}
+
+/**
+ * ̃v : dst[ n ] = start + step * n
+ *
+ * ݂ł͂Ȃ|Zŋ߂̂ŁAubNł덷~ςȂ
+ */
+inline void ramp( float* dst, float start, float step, int frames )
+{
+	int n = 0;
+
+#ifdef HAND_DSP_SSE
+	const __m128 s = _mm_set1_ps( start );
+	const __m128 d = _mm_set1_ps( step );
+	const __m128 four = _mm_set1_ps( 4.f );
+
+	__m128 index = _mm_setr_ps( 0.f, 1.f, 2.f, 3.f );
+
+	for ( ; n + 4 <= frames; n += 4 )
+	{
+		_mm_storeu_ps( dst + n, _mm_add_ps( s, _mm_mul_ps( d, index ) ) );
+		index = _mm_add_ps( index, four );
+	}
+#endif
+
+	for ( ; n < frames; n++ )
+	{
+		dst[ n ] = start + step * static_cast< float >( n );
+	}
+}
+
+} // namespace dsp
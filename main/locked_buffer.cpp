@@ -0,0 +1,60 @@
+#include "locked_buffer.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace common
+{
+
+#ifdef _WIN32
+
+bool lock_memory( void* data, size_t size )
+{
+	if ( VirtualLock( data, size ) )
+	{
+		return true;
+	}
+
+	// Œły[W̓[LOZbg̍ŏTCYŐĂ̂ŁALĂ蒼
+	SIZE_T min_size = 0;
+	SIZE_T max_size = 0;
+
+	if ( ! GetProcessWorkingSetSize( GetCurrentProcess(), & min_size, & max_size ) )
+	{
+		return false;
+	}
+
+	if ( ! SetProcessWorkingSetSize( GetCurrentProcess(), min_size + size, std::max( max_size, min_size + size ) ) )
+	{
+		return false;
+	}
+
+	return VirtualLock( data, size ) != 0;
+}
+
+void unlock_memory( void* data, size_t size )
+{
+	VirtualUnlock( data, size );
+}
+
+#else
+
+bool lock_memory( void* data, size_t size )
+{
+	return mlock( data, size ) == 0;
+}
+
+void unlock_memory( void* data, size_t size )
+{
+	munlock( data, size );
+}
+
+#endif
+
+} // namespace common
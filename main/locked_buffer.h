@@ -0,0 +1,75 @@
+#ifndef COMMON_LOCKED_BUFFER_H
+#define COMMON_LOCKED_BUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+namespace common
+{
+
+/// 𕨗ɌŒ肷 ( XbvAEgȂ )BŒłȂ false Ԃ
+bool lock_memory( void* data, size_t size );
+void unlock_memory( void* data, size_t size );
+
+/**
+ * mێɑSy[WɐGĕɌŒ肷Œ蒷̃obt@
+ *
+ * I[fBIXbhǂݏĂy[WtHgNȂ悤ɂ
+ * ŒłȂꍇ ( NH[^̕s ) Ay[WɐGꂽԂ̃obt@ƂĂ͎g
+ */
+template< typename Type >
+class locked_buffer
+{
+private:
+	std::unique_ptr< Type[] > data_;
+	size_t size_ = 0;
+	bool is_locked_ = false;
+
+public:
+	locked_buffer() { }
+	explicit locked_buffer( size_t size ) { allocate( size ); }
+	~locked_buffer() { release(); }
+
+	locked_buffer( const locked_buffer& ) = delete;
+	locked_buffer& operator = ( const locked_buffer& ) = delete;
+
+	void allocate( size_t size )
+	{
+		release();
+
+		data_.reset( new Type[ size ]() );
+		size_ = size;
+
+		// Sy[WɐGĂ
+		std::memset( data_.get(), 0, sizeof( Type ) * size_ );
+
+		is_locked_ = lock_memory( data_.get(), sizeof( Type ) * size_ );
+	}
+
+	void release()
+	{
+		if ( is_locked_ )
+		{
+			unlock_memory( data_.get(), sizeof( Type ) * size_ );
+			is_locked_ = false;
+		}
+
+		data_.reset();
+		size_ = 0;
+	}
+
+	Type* data() { return data_.get(); }
+	const Type* data() const { return data_.get(); }
+
+	Type& operator [] ( size_t n ) { return data_[ n ]; }
+	const Type& operator [] ( size_t n ) const { return data_[ n ]; }
+
+	size_t size() const { return size_; }
+	bool is_locked() const { return is_locked_; }
+
+}; // class locked_buffer
+
+} // namespace common
+
+#endif // COMMON_LOCKED_BUFFER_H
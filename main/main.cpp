@@ -1,7 +1,51 @@
+#include "Config.h"
 #include "Hand.h"
+#include "LeapFrameReplayer.h"
+#include "OfflineRenderer.h"
 
-int main( int, char** )
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main( int argc, char** argv )
 {
+	// main --render <L^t[̃t@C> <o͂ WAV t@C> [ b ] [ ̓XNvg ]
+	if ( argc >= 4 && std::string( argv[ 1 ] ) == "--render" )
+	{
+		LeapFrameReplayer replayer;
+
+		if ( ! replayer.open( argv[ 2 ] ) )
+		{
+			std::cout << "could not open : " << argv[ 2 ] << std::endl;
+			return 1;
+		}
+
+		const double seconds = argc >= 5 ? std::atof( argv[ 4 ] ) : replayer.get_duration() / 1000000.0 + 2.0;
+
+		ScriptedInput input;
+
+		if ( argc >= 6 && ! input.load( argv[ 5 ] ) )
+		{
+			std::cout << "could not open : " << argv[ 5 ] << std::endl;
+			return 1;
+		}
+
+		// CuƓɂȂ悤ɁAconfig.txt ΃TvO[gEobt@TCYEe|E`l̊蓖Ă킹
+		Config config;
+		config.load_file( "./config.txt" );
+
+		ChannelMap channel_map;
+		channel_map.load( config );
+
+		OfflineRenderer renderer(
+			config.get( "audio.frames_per_second", HandAudioCallback::DEFAULT_FRAMES_PER_SECOND ),
+			config.get( "audio.frames_per_buffer", static_cast< int >( HandAudioCallback::DEFAULT_FRAMES_PER_BUFFER ) ),
+			config.get( "audio.bpm", HandAudioCallback::DEFAULT_BPM ),
+			channel_map );
+
+		return renderer.render( replayer, argv[ 3 ], seconds, & input ) ? 0 : 1;
+	}
+
 	Hand hand;
 	hand.start();
 
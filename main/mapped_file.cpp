@@ -0,0 +1,127 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace common
+{
+
+#ifdef _WIN32
+
+bool mapped_file::open( const char* file_name )
+{
+	close();
+
+	HANDLE file = CreateFileA( file_name, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+	if ( file == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+
+	LARGE_INTEGER size;
+
+	if ( ! GetFileSizeEx( file, & size ) || size.QuadPart == 0 )
+	{
+		CloseHandle( file );
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+	if ( ! mapping )
+	{
+		CloseHandle( file );
+		return false;
+	}
+
+	const void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+
+	if ( ! data )
+	{
+		CloseHandle( mapping );
+		CloseHandle( file );
+		return false;
+	}
+
+	file_handle_ = file;
+	mapping_handle_ = mapping;
+	data_ = data;
+	size_ = static_cast< size_t >( size.QuadPart );
+
+	return true;
+}
+
+void mapped_file::close()
+{
+	if ( data_ )
+	{
+		UnmapViewOfFile( data_ );
+		CloseHandle( mapping_handle_ );
+		CloseHandle( file_handle_ );
+	}
+
+	data_ = nullptr;
+	size_ = 0;
+	file_handle_ = nullptr;
+	mapping_handle_ = nullptr;
+}
+
+#else
+
+bool mapped_file::open( const char* file_name )
+{
+	close();
+
+	const int fd = ::open( file_name, O_RDONLY );
+
+	if ( fd < 0 )
+	{
+		return false;
+	}
+
+	struct stat st;
+
+	if ( fstat( fd, & st ) != 0 || st.st_size == 0 )
+	{
+		::close( fd );
+		return false;
+	}
+
+	void* data = mmap( nullptr, static_cast< size_t >( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+
+	// mmap ̓t@CĂL
+	::close( fd );
+
+	if ( data == MAP_FAILED )
+	{
+		return false;
+	}
+
+	data_ = data;
+	size_ = static_cast< size_t >( st.st_size );
+
+	return true;
+}
+
+void mapped_file::close()
+{
+	if ( data_ )
+	{
+		munmap( const_cast< void* >( data_ ), size_ );
+	}
+
+	data_ = nullptr;
+	size_ = 0;
+}
+
+#endif
+
+} // namespace common
@@ -0,0 +1,41 @@
+#ifndef COMMON_MAPPED_FILE_H
+#define COMMON_MAPPED_FILE_H
+
+#include <cstddef>
+
+namespace common
+{
+
+/**
+ * ǂݍݐp memory map t@C
+ */
+class mapped_file
+{
+private:
+	const void* data_ = nullptr;
+	size_t size_ = 0;
+
+	void* file_handle_ = nullptr;		/// Windows : t@C̃nh
+	void* mapping_handle_ = nullptr;	/// Windows : t@C}bsÕnh
+
+public:
+	mapped_file() { }
+	explicit mapped_file( const char* file_name ) { open( file_name ); }
+	~mapped_file() { close(); }
+
+	mapped_file( const mapped_file& ) = delete;
+	mapped_file& operator = ( const mapped_file& ) = delete;
+
+	bool open( const char* );
+	void close();
+
+	bool is_open() const { return data_ != nullptr; }
+
+	const void* data() const { return data_; }
+	size_t size() const { return size_; }
+
+}; // class mapped_file
+
+} // namespace common
+
+#endif // COMMON_MAPPED_FILE_H
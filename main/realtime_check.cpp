@@ -0,0 +1,37 @@
+#include "realtime_check.h"
+
+#ifdef HAND_REALTIME_CHECK
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+namespace common
+{
+
+thread_local int realtime_depth = 0;
+
+} // namespace common
+
+static void* allocate( size_t size )
+{
+	// I[fBIXbhŃmۂĂ
+	assert( ! common::is_in_realtime_scope() );
+
+	if ( void* p = std::malloc( size ? size : 1 ) )
+	{
+		return p;
+	}
+
+	throw std::bad_alloc();
+}
+
+void* operator new ( size_t size ) { return allocate( size ); }
+void* operator new [] ( size_t size ) { return allocate( size ); }
+
+void operator delete ( void* p ) noexcept { std::free( p ); }
+void operator delete [] ( void* p ) noexcept { std::free( p ); }
+void operator delete ( void* p, size_t ) noexcept { std::free( p ); }
+void operator delete [] ( void* p, size_t ) noexcept { std::free( p ); }
+
+#endif // HAND_REALTIME_CHECK
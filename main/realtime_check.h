@@ -0,0 +1,49 @@
+#ifndef COMMON_REALTIME_CHECK_H
+#define COMMON_REALTIME_CHECK_H
+
+/**
+ * A^CXbhł̃mۂo
+ *
+ * HAND_REALTIME_CHECK `Ăꍇ ( fobOrhł͊Œ` ) ́A
+ * realtime_scope ͈͓̔ operator new Ă΂ assert Ŏ~߂
+ * `ĂȂꍇ͉Ȃ
+ */
+#if defined( _DEBUG ) && ! defined( HAND_REALTIME_CHECK )
+#define HAND_REALTIME_CHECK
+#endif
+
+namespace common
+{
+
+#ifdef HAND_REALTIME_CHECK
+
+/// ݂̃Xbh realtime_scope ͈͓̔ɂ[
+extern thread_local int realtime_depth;
+
+class realtime_scope
+{
+public:
+	realtime_scope() { realtime_depth++; }
+	~realtime_scope() { realtime_depth--; }
+
+	realtime_scope( const realtime_scope& ) = delete;
+	realtime_scope& operator = ( const realtime_scope& ) = delete;
+};
+
+inline bool is_in_realtime_scope() { return realtime_depth > 0; }
+
+#else
+
+class realtime_scope
+{
+public:
+	realtime_scope() { }
+};
+
+inline bool is_in_realtime_scope() { return false; }
+
+#endif
+
+} // namespace common
+
+#endif // COMMON_REALTIME_CHECK_H
@@ -0,0 +1,80 @@
+#ifndef COMMON_SPSC_QUEUE_H
+#define COMMON_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace common
+{
+
+/**
+ * 1 ̏݃Xbh 1 ̓ǂݍ݃XbhŎgŒ蒷̃bNt[L[
+ *
+ * vf͑SĎOɊmۂ̂ push() / pop() ̓mۂȂ
+ * Capacity  2 ̗ݏłȂ΂ȂȂ
+ */
+template< typename Type, size_t Capacity >
+class spsc_queue
+{
+	static_assert( Capacity >= 2 && ( Capacity & ( Capacity - 1 ) ) == 0, "spsc_queue capacity must be a power of two" );
+
+private:
+	static const size_t INDEX_MASK = Capacity - 1;
+
+	Type buffer_[ Capacity ];
+
+	alignas( 64 ) std::atomic< size_t > head_;		/// ɓǂݍވʒu ( ǂݍݑXV )
+	alignas( 64 ) std::atomic< size_t > tail_;		/// ɏވʒu ( ݑXV )
+
+public:
+	spsc_queue()
+		: head_( 0 )
+		, tail_( 0 )
+	{
+
+	}
+
+	/// ݑ : L[t̏ꍇ͉ false Ԃ
+	bool push( const Type& value )
+	{
+		const size_t tail = tail_.load( std::memory_order_relaxed );
+
+		if ( tail - head_.load( std::memory_order_acquire ) >= Capacity )
+		{
+			return false;
+		}
+
+		buffer_[ tail & INDEX_MASK ] = value;
+		tail_.store( tail + 1, std::memory_order_release );
+
+		return true;
+	}
+
+	/// ǂݍݑ : L[̏ꍇ͉ false Ԃ
+	bool pop( Type& value )
+	{
+		const size_t head = head_.load( std::memory_order_relaxed );
+
+		if ( head == tail_.load( std::memory_order_acquire ) )
+		{
+			return false;
+		}
+
+		value = buffer_[ head & INDEX_MASK ];
+		head_.store( head + 1, std::memory_order_release );
+
+		return true;
+	}
+
+	bool empty() const
+	{
+		return head_.load( std::memory_order_acquire ) == tail_.load( std::memory_order_acquire );
+	}
+
+	size_t capacity() const { return Capacity; }
+
+}; // class spsc_queue
+
+} // namespace common
+
+#endif // COMMON_SPSC_QUEUE_H
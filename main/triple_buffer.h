@@ -0,0 +1,74 @@
+#ifndef COMMON_TRIPLE_BUFFER_H
+#define COMMON_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <type_traits>
+
+namespace common
+{
+
+/**
+ * 1 ̏݃Xbh 1 ̓ǂݍ݃Xbh֒l󂯓ngvobt@
+ *
+ * ݑ back() ɏł publish() Aǂݍݑ update() Ă front() ǂ
+ * ǂ wait-free ŁAǂݍݑ͏ publish ꂽ 1 ̒lŜQƂ
+ */
+template< typename Type >
+class triple_buffer
+{
+	static_assert( std::is_trivially_destructible< Type >::value, "triple_buffer requires a POD like type" );
+
+private:
+	static const unsigned int INDEX_MASK = 0b011;
+	static const unsigned int DIRTY_BIT  = 0b100;
+
+	struct alignas( 64 ) slot
+	{
+		Type value;
+	};
+
+	slot slot_[ 3 ];
+
+	alignas( 64 ) std::atomic< unsigned int > middle_;	/// 󂯓ñobt@̔ԍ | ǃtO
+	alignas( 64 ) unsigned int back_;					/// ݑ̃obt@̔ԍ
+	alignas( 64 ) unsigned int front_;					/// ǂݍݑ̃obt@̔ԍ
+
+public:
+	triple_buffer()
+		: middle_( 1 )
+		, back_( 0 )
+		, front_( 2 )
+	{
+
+	}
+
+	/// ݑ :  publish l
+	Type& back() { return slot_[ back_ ].value; }
+
+	/// ݑ : back() ǂݍݑɌJ
+	void publish()
+	{
+		back_ = middle_.exchange( back_ | DIRTY_BIT, std::memory_order_acq_rel ) & INDEX_MASK;
+	}
+
+	/// ǂݍݑ : Vl publish Ă front() ւ
+	bool update()
+	{
+		if ( ! ( middle_.load( std::memory_order_relaxed ) & DIRTY_BIT ) )
+		{
+			return false;
+		}
+
+		front_ = middle_.exchange( front_, std::memory_order_acq_rel ) & INDEX_MASK;
+
+		return true;
+	}
+
+	/// ǂݍݑ : Ō update() _̒l
+	const Type& front() const { return slot_[ front_ ].value; }
+
+}; // class triple_buffer
+
+} // namespace common
+
+#endif // COMMON_TRIPLE_BUFFER_H
@@ -99,8 +99,8 @@ void ofApp::draw(){
 		ofDrawRectRounded( ofRectangle( rx - rh_point_size_ / 2.f, ry - rh_point_size_ / 2.f, rh_point_size_, rh_point_size_ ), 5.f );
 	}
 
-	draw_text( font_big_, HandAudio::get_page_name( audio().get_page() ), ofGetWindowHeight() / 4 );
-	draw_text( font_big_, HandAudio::get_page_name( audio().get_next_page() ), ofGetWindowHeight() / 4 * 3 );
+	draw_text( font_big_, get_page_name( audio().get_page() ), ofGetWindowHeight() / 4 );
+	draw_text( font_big_, get_page_name( audio().get_next_page() ), ofGetWindowHeight() / 4 * 3 );
 
 	const std::string data_text = (
 		boost::format( "%0.3f    %d-%d-%d    %0.3f " )